@@ -1,16 +1,21 @@
 #include <BMCP.hpp>
+#include <Portfolio.hpp>
 #include <cstdlib>
 #include <cstdio>
 
-void BMCP::BMCPSolver::Add_Item(const int item)
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Add_Item(const int item)
 {
+    BMCP_STAT(stats.current().moves++; stats.current().elements += g->item_neighbor[item].size());
     solution_size++;
     solution[item] = 1;
     solution_weight_sum += g->weight[item];
+    Pool_Remove(item);
 
     for (int elem_nei: g->item_neighbor[item])
     {
         solution_elements[elem_nei] += 1;
+        solution_owner[elem_nei] ^= item;
         if (solution_elements[elem_nei] == 1)
         {
             solution_profit_sum += g->profit[elem_nei];
@@ -18,30 +23,34 @@ void BMCP::BMCPSolver::Add_Item(const int item)
             {
                 if (solution[item_nei]) continue;
                 solution_contribution[item_nei] -= g->profit[elem_nei];
+                if (solution_contribution[item_nei] == 0) Pool_Remove(item_nei);
             }
         }
         else if (solution_elements[elem_nei] == 2)
         {
-            for (int item_nei: g->element_neighbor[elem_nei])
-            {
-                if (!solution[item_nei]) continue;
-                if (item_nei == item) continue;
-                solution_contribution[item_nei] -= g->profit[elem_nei];
-                break;
-            }
+            int item_nei = solution_owner[elem_nei] ^ item;
+            solution_contribution[item_nei] -= g->profit[elem_nei];
+            if (removal_indexed) removal_heap.update(item_nei, solution_contribution[item_nei]);
         }
     }
+    if (journaling) Journal(journal_add, item);
 }
 
-void BMCP::BMCPSolver::Remove_Item(const int item)
+template<typename Numeric>
+template<bool note>
+void BMCP::BMCPSolver<Numeric>::Remove_Item(const int item)
 {
+    BMCP_STAT(stats.current().moves++; stats.current().elements += g->item_neighbor[item].size());
     solution_size--;
     solution[item] = 0;
     solution_weight_sum -= g->weight[item];
+    if (solution_contribution[item] != 0) Pool_Insert(item);
+    if constexpr (note) Note_Change(item);
 
     for (int elem_nei: g->item_neighbor[item])
     {
         solution_elements[elem_nei]--;
+        solution_owner[elem_nei] ^= item;
         if (solution_elements[elem_nei] == 0)
         {
             solution_profit_sum -= g->profit[elem_nei];
@@ -49,25 +58,29 @@ void BMCP::BMCPSolver::Remove_Item(const int item)
             {
                 if (item_nei == item) continue;
                 solution_contribution[item_nei] += g->profit[elem_nei];
+                if (solution_contribution[item_nei] == g->profit[elem_nei] && g->profit[elem_nei] != 0)
+                    Pool_Insert(item_nei);
+                if constexpr (note) Note_Change(item_nei);
             }
         }
         else if (solution_elements[elem_nei] == 1)
         {
-            for (int item_nei: g->element_neighbor[elem_nei])
-            {
-                if (!solution[item_nei]) continue;
-                solution_contribution[item_nei] += g->profit[elem_nei];
-                break;
-            }
+            int item_nei = solution_owner[elem_nei];
+            solution_contribution[item_nei] += g->profit[elem_nei];
+            if (removal_indexed) removal_heap.update(item_nei, solution_contribution[item_nei]);
         }
     }
+    if (journaling) Journal(journal_remove, item);
 }
 
-void BMCP::BMCPSolver::Add_Item_With_Conf_Change(const int item, const int iter)
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Add_Item_With_Conf_Change(const int item, const int iter)
 {
+    BMCP_STAT(stats.current().moves++; stats.current().elements += g->item_neighbor[item].size());
     solution_size++;
     solution[item] = 1;
     solution_weight_sum += g->weight[item];
+    Pool_Remove(item);
 
     origin_conf_change_in_solution[item] = conf_change_in_solution[item] = solution_contribution[item];
     conf_change_timestamp[item] = iter + rand_deviation(tabu_length1);
@@ -75,6 +88,7 @@ void BMCP::BMCPSolver::Add_Item_With_Conf_Change(const int item, const int iter)
     for (int elem_nei: g->item_neighbor[item])
     {
         solution_elements[elem_nei] += 1;
+        solution_owner[elem_nei] ^= item;
         if (solution_elements[elem_nei] == 1)
         {
             solution_profit_sum += g->profit[elem_nei];
@@ -82,28 +96,29 @@ void BMCP::BMCPSolver::Add_Item_With_Conf_Change(const int item, const int iter)
             {
                 if (solution[item_nei]) continue;
                 solution_contribution[item_nei] -= g->profit[elem_nei];
+                if (solution_contribution[item_nei] == 0) Pool_Remove(item_nei);
                 conf_change_out_of_solution[item_nei] -= g->profit[elem_nei];
             }
         }
         else if (solution_elements[elem_nei] == 2)
         {
-            for (int item_nei: g->element_neighbor[elem_nei])
-            {
-                if (!solution[item_nei]) continue;
-                if (item_nei == item) continue;
-                solution_contribution[item_nei] -= g->profit[elem_nei];
-                conf_change_in_solution[item_nei] -= g->profit[elem_nei];
-                break;
-            }
+            int item_nei = solution_owner[elem_nei] ^ item;
+            solution_contribution[item_nei] -= g->profit[elem_nei];
+            conf_change_in_solution[item_nei] -= g->profit[elem_nei];
+            if (removal_indexed) removal_heap.update(item_nei, solution_contribution[item_nei]);
         }
     }
+    if (journaling) Journal(journal_add, item);
 }
 
-void BMCP::BMCPSolver::Remove_Item_With_Conf_Change(const int item, const int iter)
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Remove_Item_With_Conf_Change(const int item, const int iter)
 {
+    BMCP_STAT(stats.current().moves++; stats.current().elements += g->item_neighbor[item].size());
     solution_size--;
     solution[item] = 0;
     solution_weight_sum -= g->weight[item];
+    if (solution_contribution[item] != 0) Pool_Insert(item);
 
     origin_conf_change_out_of_solution[item] = conf_change_out_of_solution[item] = solution_contribution[item];
     conf_change_timestamp[item] = iter + rand_deviation(tabu_length1);
@@ -111,6 +126,7 @@ void BMCP::BMCPSolver::Remove_Item_With_Conf_Change(const int item, const int it
     for (int elem_nei: g->item_neighbor[item])
     {
         solution_elements[elem_nei]--;
+        solution_owner[elem_nei] ^= item;
         if (solution_elements[elem_nei] == 0)
         {
             solution_profit_sum -= g->profit[elem_nei];
@@ -118,28 +134,38 @@ void BMCP::BMCPSolver::Remove_Item_With_Conf_Change(const int item, const int it
             {
                 if (item_nei == item) continue;
                 solution_contribution[item_nei] += g->profit[elem_nei];
+                if (solution_contribution[item_nei] == g->profit[elem_nei] && g->profit[elem_nei] != 0)
+                    Pool_Insert(item_nei);
                 conf_change_out_of_solution[item_nei] -= g->profit[elem_nei];
             }
         }
         else if (solution_elements[elem_nei] == 1)
         {
-            for (int item_nei: g->element_neighbor[elem_nei])
-            {
-                if (!solution[item_nei]) continue;
-                solution_contribution[item_nei] += g->profit[elem_nei];
-                conf_change_in_solution[item_nei] -= g->profit[elem_nei];
-                break;
-            }
+            int item_nei = solution_owner[elem_nei];
+            solution_contribution[item_nei] += g->profit[elem_nei];
+            conf_change_in_solution[item_nei] -= g->profit[elem_nei];
+            if (removal_indexed) removal_heap.update(item_nei, solution_contribution[item_nei]);
         }
     }
+    if (journaling) Journal(journal_remove, item);
 }
 
-void BMCP::BMCPSolver::Solution_To_Best_Solution()
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Solution_To_Best_Solution()
 {
-    in_best_solution = in_solution;
+    BMCP_STAT(if (solution_profit_sum > best_solution_profit_sum) stats.current().improvements++);
+    BMCP_STAT(PhaseScope scope(stats, phase_snapshot));
     best_solution_profit_sum = solution_profit_sum;
     best_solution_weight_sum = solution_weight_sum;
     best_solution_size = solution_size;
+    if (journal_snapshots)
+    {
+        //best is the current state minus the (now empty) journal
+        Start_Journal();
+        return;
+    }
+    BMCP_STAT(stats.current().scans++);
+    in_best_solution = in_solution;
     for (int i = 1; i <= g->m; i++)
     {
         best_solution[i] = solution[i];
@@ -148,158 +174,586 @@ void BMCP::BMCPSolver::Solution_To_Best_Solution()
     for (int i = 1; i <= g->n; i++)
     {
         best_solution_elements[i] = solution_elements[i];
+        best_solution_owner[i] = solution_owner[i];
     }
+    best_in_arrays = true;
+    snapshot_copies++;
 }
 
-void BMCP::BMCPSolver::Solution_To_Star_Solution()
+template<typename Numeric>
+bool BMCP::BMCPSolver<Numeric>::Solution_To_Star_Solution()
 {
+    //only the item list, the arrays can be rebuilt from it when needed
     in_star_solution = in_solution;
     star_solution_profit_sum = solution_profit_sum;
     star_solution_weight_sum = solution_weight_sum;
     star_solution_size = solution_size;
+    star_solution_iterations = total_iterations;
+    star_solution_time = Get_Time();
+    if (shared == nullptr) return true;
+    return shared->Publish(star_solution_profit_sum, in_star_solution.begin(), in_star_solution.end());
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Improve_Star(const Phase phase)
+{
+    if (solution_profit_sum <= star_solution_profit_sum || !Solution_To_Star_Solution()) return;
+    Improvement event{star_solution_time, total_iterations, (ll) star_solution_profit_sum,
+                      (ll) star_solution_weight_sum, phase};
+    trace.record(event);
+    if (improvement_callback) improvement_callback(event);
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Set_Initial_Solution(const std::vector<int> &items)
+{
+    initial_solution = items;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::On_Improvement(ImprovementCallback callback)
+{
+    improvement_callback = std::move(callback);
+}
+
+template<typename Numeric>
+const BMCP::ImprovementTrace &BMCP::BMCPSolver<Numeric>::Trace() const
+{
+    return trace;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Use_Pool(WorkerPool *workers)
+{
+    pool = workers;
+    part_best.assign(pool == nullptr ? 1 : pool->threads(), -1);
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Use_Swaps(const int samples)
+{
+    swap_samples = samples;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Share(SharedStar *star, const bool adopt)
+{
+    shared = star;
+    adopt_shared = adopt;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Join_Islands(SharedStar *own_inbox, const std::vector<SharedStar *> &targets,
+                                             const int period)
+{
+    inbox = own_inbox;
+    neighbours = targets;
+    migration_period = period;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Load_Solution(const std::vector<int> &items)
+{
+    //only the difference is moved, so only the items around it are updated
+    for (int item: items)
+        load_mark[item] = 1;
+    for (int i = 0; i < in_solution.size();)
+    {
+        int item = in_solution[i];
+        if (load_mark[item])
+        {
+            i++;
+            continue;
+        }
+        Erase_In_Solution(i);
+        Remove_Item(item);
+    }
+    for (int item: items)
+    {
+        load_mark[item] = 0;
+        if (solution[item]) continue;
+        Add_Item(item);
+        Insert_In_Solution(item);
+    }
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Adopt_Shared()
+{
+    //only a solver whose own star is behind and has not moved for a while gives up its
+    //trajectory; it continues from the global best, which becomes its star
+    const SharedStar::Snapshot *best = shared->Load();
+    if (best == nullptr || best->profit <= star_solution_profit_sum) return;
+    if (total_iterations - star_solution_iterations < adopt_after) return;
+    Load_Solution(best->items);
+    Solution_To_Star_Solution();
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Migrate()
+{
+    //send the star to one neighbour, then continue from an immigrant better than the star
+    if (total_iterations % migration_period != 0) return;
+    SharedStar *target = neighbours[neighbours.size() == 1 ? 0 : random.next() % neighbours.size()];
+    target->Publish(star_solution_profit_sum, in_star_solution.begin(), in_star_solution.end());
+    const SharedStar::Snapshot *immigrant = inbox->Load();
+    if (immigrant == nullptr || immigrant->profit <= star_solution_profit_sum) return;
+    Load_Solution(immigrant->items);
+    Solution_To_Star_Solution();
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Best_Solution_To_Solution()
+{
+    BMCP_STAT(PhaseScope scope(stats, phase_snapshot));
+    if (best_in_arrays)
+    {
+        BMCP_STAT(stats.current().scans++);
+        in_solution = in_best_solution;
+        solution_profit_sum = best_solution_profit_sum;
+        solution_weight_sum = best_solution_weight_sum;
+        solution_size = best_solution_size;
+        for (int i = 1; i <= g->m; i++)
+        {
+            solution[i] = best_solution[i];
+            solution_contribution[i] = best_solution_contribution[i];
+        }
+        for (int i = 1; i <= g->n; i++)
+        {
+            solution_elements[i] = best_solution_elements[i];
+            solution_owner[i] = best_solution_owner[i];
+        }
+        snapshot_copies++;
+        Build_Candidates();
+    }
+    else
+        Roll_Back();
+    if (journal_snapshots)
+        Start_Journal();
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Start_Journal()
+{
+    journal.clear();
+    journal_cost = 0;
+    journaling = true;
+    best_in_arrays = false;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Roll_Back()
+{
+    //undo the journal newest first; the moves go through the update functions, so everything
+    //derived from the solution follows
+    journaling = false;
+    for (int k = (int) journal.size() - 1; k >= 0; k--)
+    {
+        const JournalEntry &entry = journal[k];
+        switch (entry.type)
+        {
+            case journal_add:
+                Remove_Item(entry.item);
+                break;
+            case journal_remove:
+                Add_Item(entry.item);
+                break;
+            case journal_insert:
+                in_solution.pop_back();
+                break;
+            case journal_erase:
+                in_solution.push_back(entry.item);
+                std::swap(in_solution[entry.idx], in_solution.back());
+                break;
+        }
+    }
+    snapshot_rollbacks += (ll) journal.size();
+    journal.clear();
+    journal_cost = 0;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Checkpoint_Best()
+{
+    BMCP_STAT(PhaseScope scope(stats, phase_snapshot));
+    BMCP_STAT(stats.current().scans++);
+    //the journal got longer than a copy: write best into the best arrays by copying the
+    //current state and undoing the journal on the copy, then stop journaling
+    in_best_solution = in_solution;
     for (int i = 1; i <= g->m; i++)
     {
-        star_solution[i] = solution[i];
-        star_solution_contribution[i] = solution_contribution[i];
+        best_solution[i] = solution[i];
+        best_solution_contribution[i] = solution_contribution[i];
     }
     for (int i = 1; i <= g->n; i++)
     {
-        star_solution_elements[i] = solution_elements[i];
+        best_solution_elements[i] = solution_elements[i];
+        best_solution_owner[i] = solution_owner[i];
+    }
+    for (int k = (int) journal.size() - 1; k >= 0; k--)
+    {
+        const JournalEntry &entry = journal[k];
+        switch (entry.type)
+        {
+            case journal_add:
+                Toggle_Best(entry.item);
+                break;
+            case journal_remove:
+                Toggle_Best(entry.item);
+                break;
+            case journal_insert:
+                in_best_solution.pop_back();
+                break;
+            case journal_erase:
+                in_best_solution.push_back(entry.item);
+                std::swap(in_best_solution[entry.idx], in_best_solution.back());
+                break;
+        }
+    }
+    journal.clear();
+    journal_cost = 0;
+    journaling = false;
+    best_in_arrays = true;
+    snapshot_copies++;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Toggle_Best(const int item)
+{
+    BMCP_STAT(stats.current().moves++; stats.current().elements += g->item_neighbor[item].size());
+    //Add_Item / Remove_Item on the best arrays, without the sums and derived structures
+    if (!best_solution[item])
+    {
+        best_solution[item] = 1;
+        for (int elem_nei: g->item_neighbor[item])
+        {
+            best_solution_elements[elem_nei]++;
+            best_solution_owner[elem_nei] ^= item;
+            if (best_solution_elements[elem_nei] == 1)
+            {
+                for (int item_nei: g->element_neighbor[elem_nei])
+                {
+                    if (best_solution[item_nei]) continue;
+                    best_solution_contribution[item_nei] -= g->profit[elem_nei];
+                }
+            }
+            else if (best_solution_elements[elem_nei] == 2)
+                best_solution_contribution[best_solution_owner[elem_nei] ^ item] -= g->profit[elem_nei];
+        }
+    }
+    else
+    {
+        best_solution[item] = 0;
+        for (int elem_nei: g->item_neighbor[item])
+        {
+            best_solution_elements[elem_nei]--;
+            best_solution_owner[elem_nei] ^= item;
+            if (best_solution_elements[elem_nei] == 0)
+            {
+                for (int item_nei: g->element_neighbor[elem_nei])
+                {
+                    if (item_nei == item) continue;
+                    best_solution_contribution[item_nei] += g->profit[elem_nei];
+                }
+            }
+            else if (best_solution_elements[elem_nei] == 1)
+                best_solution_contribution[best_solution_owner[elem_nei]] += g->profit[elem_nei];
+        }
     }
 }
 
-void BMCP::BMCPSolver::Best_Solution_To_Solution()
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Build_Candidates()
 {
-    in_solution = in_best_solution;
-    solution_profit_sum = best_solution_profit_sum;
-    solution_weight_sum = best_solution_weight_sum;
-    solution_size = best_solution_size;
+    BMCP_STAT(stats.current().scans++);
+    candidates.clear();
     for (int i = 1; i <= g->m; i++)
     {
-        solution[i] = best_solution[i];
-        solution_contribution[i] = best_solution_contribution[i];
+        if (solution[i]) continue;
+        if (solution_contribution[i] == 0) continue;
+        candidates.insert(i);
     }
-    for (int i = 1; i <= g->n; i++)
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Note_Move(const int item)
+{
+    //an element covered by item alone (added) or by nobody (removed) changed every item out
+    //of solution around it, an element left with one other cover changed that cover only
+    Note_Change(item);
+    int alone = solution[item] ? 1 : 0;
+    for (int elem_nei: g->item_neighbor[item])
     {
-        solution_elements[i] = best_solution_elements[i];
+        if (solution_elements[elem_nei] == alone)
+        {
+            for (int item_nei: g->element_neighbor[elem_nei])
+            {
+                if (solution[item_nei]) continue;
+                Note_Change(item_nei);
+            }
+        }
+        else if (solution_elements[elem_nei] == alone + 1)
+        {
+            Note_Change(solution_owner[elem_nei] ^ (solution[item] ? item : 0));
+        }
     }
 }
 
-void BMCP::BMCPSolver::Greedy_Initialization()
+template<typename Numeric>
+bool BMCP::BMCPSolver<Numeric>::Drain_Changes()
 {
+    //queue the new key of every changed item out of solution,
+    //report whether an item in solution no longer contributes
+    bool zero = false;
+    for (int item: changed_items)
+    {
+        changed_mark[item] = 0;
+        if (solution[item])
+        {
+            if (solution_contribution[item] == 0)
+                zero = true;
+        }
+        else if (solution_contribution[item] != 0)
+            greedy_heap.push(solution_contribution[item], g->weight[item], item);
+    }
+    changed_items.clear();
+    return zero;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Greedy_Initialization()
+{
+    BMCP_STAT(PhaseScope scope(stats, phase_greedy));
+    BMCP_STAT(stats.current().scans++);
     //init in_solution
     in_solution.clear();
-    while (solution_weight_sum <= g->C && solution_size < g->m)
+
+    //the heap holds one entry per change of an item's contribution, the live one of each
+    //item is the entry matching solution_contribution; items that do not fit wait in
+    //greedy_deferred until a removal frees capacity
+    greedy_heap.clear();
+    greedy_deferred.clear();
+    for (int i = 1; i <= g->m; i++)
+    {
+        if (solution[i]) continue;
+        if (solution_contribution[i] == 0) continue;
+        greedy_heap.push(solution_contribution[i], g->weight[i], i);
+    }
+
+    //a stop keeps the items added so far, every prefix of the greedy fits
+    int adds = 0;
+    while (solution_weight_sum <= g->C && solution_size < g->m && !Poll_Stop(adds))
     {
         //select the item with the highest density under the premise that total weight <= C
         int ustar = -1;
-        for (int i = 1; i <= g->m; i++)
+        while (!greedy_heap.empty())
         {
+            RatioHeap::Entry top = greedy_heap.top();
+            greedy_heap.pop();
+            int i = top.id;
             if (solution[i]) continue;
-            if (g->weight[i] + solution_weight_sum > g->C) continue;
-            if (solution_contribution[i] == 0) continue;
-            if (ustar == -1)
+            if (solution_contribution[i] != top.contribution) continue;
+            if (g->weight[i] + solution_weight_sum > g->C)
             {
-                ustar = i;
+                greedy_deferred.push_back(i);
                 continue;
             }
-            if (solution_contribution[i] * g->weight[ustar] > solution_contribution[ustar] * g->weight[i])
-                ustar = i;
+            ustar = i;
+            break;
         }
         if (ustar != -1)
         {
             Add_Item(ustar);
             //printf("add %d\n",ustar);
-            in_solution.insert(ustar);
+            Insert_In_Solution(ustar);
+            Note_Move(ustar);
+            adds++;
+            if (!Drain_Changes()) continue;
             for (int i = 0; i < in_solution.size();)
             {
                 int item = in_solution[i];
                 if (solution_contribution[item] == 0)
                 {
-                    in_solution.erase(i);
+                    Erase_In_Solution(i);
                     Remove_Item(item);
+                    Note_Move(item);
                     //printf("remove %d\n",item);
                 }
                 else
                     i++;
             }
+            Drain_Changes();
+            for (int item: greedy_deferred)
+            {
+                if (solution[item] || solution_contribution[item] == 0) continue;
+                greedy_heap.push(solution_contribution[item], g->weight[item], item);
+            }
+            greedy_deferred.clear();
         }
         else
             break;
     }
+
+    greedy_heap.clear();
+    greedy_deferred.clear();
 }
 
-int BMCP::BMCPSolver::Multiple_Selections(int amount)
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Warm_Start()
+{
+    BMCP_STAT(PhaseScope scope(stats, phase_greedy));
+    //every newly covered element walks its items once, so loading costs O(edges)
+    Load_Solution(initial_solution);
+    if (solution_weight_sum <= g->C) return;
+    Build_Removal_Heap();
+    while (solution_weight_sum > g->C)
+    {
+        int ustar = removal_heap.first([](int)
+        {
+            return false;
+        });
+        Erase_In_Solution(removal_heap.order(ustar));
+        Remove_Item(ustar);
+    }
+    removal_indexed = false;
+}
+
+template<typename Numeric>
+int BMCP::BMCPSolver<Numeric>::Multiple_Selections(int amount)
 {
     if (random_list.size() <= amount)
         return random_list.size() - 1;
     for (int i = 0; i < amount; i++)
     {
-        int random_num = rand() % (random_list.size() - i) + i;
+        int random_num = random.next() % (random_list.size() - i) + i;
         std::swap(random_list[random_num], random_list[i]);
     }
     return amount - 1;
 }
 
-double BMCP::BMCPSolver::Upper_Confidence_Bound(int item)
+template<typename Numeric>
+int BMCP::BMCPSolver<Numeric>::Multiple_Selections(IndexedSetList &list, int amount)
+{
+    if (list.size() <= amount)
+        return list.size() - 1;
+    for (int i = 0; i < amount; i++)
+    {
+        int random_num = random.next() % (list.size() - i) + i;
+        list.swap(random_num, i);
+    }
+    return amount - 1;
+}
+
+template<typename Numeric>
+double BMCP::BMCPSolver<Numeric>::Upper_Confidence_Bound(int item)
 {
     return (double) r_sum[item] / std::max(1, select_times[item]) +
            gamma * sqrt((double) bandit_count / std::max(1, select_times[item]));
 }
 
-double BMCP::BMCPSolver::r(int item)
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Build_Arms()
+{
+    arms.clear();
+    for (int item: arms_dirty)
+        arms_dirty_mark[item] = 0;
+    arms_dirty.clear();
+    for (int item: candidates)
+        arms.insert(item, std::max(1, select_times[item]), r_sum[item] / std::max(1, select_times[item]));
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Sync_Arms()
+{
+    for (int item: arms_dirty)
+    {
+        arms_dirty_mark[item] = 0;
+        if (candidates.contains(item))
+            arms.insert(item, std::max(1, select_times[item]), r_sum[item] / std::max(1, select_times[item]));
+        else
+            arms.erase(item);
+    }
+    arms_dirty.clear();
+}
+
+template<typename Numeric>
+int BMCP::BMCPSolver<Numeric>::Select_Arm()
+{
+    //the exploration term only depends on the group, so the first items of a group have its
+    //highest bound; walk each group while the bound stays equal to keep the lowest-id tie
+    Sync_Arms();
+    int ustar = -1;
+    double ustar_ucb;
+    for (auto &[times, group]: arms.groups())
+    {
+        if (group.empty()) continue;
+        double top_ucb = Upper_Confidence_Bound(group.begin()->second);
+        for (auto &[average, item]: group)
+        {
+            double tmp_ucb = Upper_Confidence_Bound(item);
+            if (tmp_ucb != top_ucb) break;
+            if (ustar == -1 || tmp_ucb > ustar_ucb || (tmp_ucb == ustar_ucb && item < ustar))
+            {
+                ustar = item;
+                ustar_ucb = tmp_ucb;
+            }
+        }
+    }
+    return ustar;
+}
+
+template<typename Numeric>
+double BMCP::BMCPSolver<Numeric>::r(int item)
 {
     return (double) solution_contribution[item] /
-           std::max(solution_weight_sum + g->weight[item] - g->C, 1);
+           std::max<value>(solution_weight_sum + g->weight[item] - g->C, 1);
 }
 
-void BMCP::BMCPSolver::CC_Search()
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::CC_Search()
 {
+    BMCP_STAT(PhaseScope scope(stats, phase_cc_search));
     Solution_To_Best_Solution();
 
+    BMCP_STAT(stats.current().scans++);
     bandit_count = 0;
-    for (int i = 1; i <= g->m; i++)
+    For_Item_Parts([this](int, const int begin, const int end)
     {
-        r_sum[i] = r(i);
-        select_times[i] = solution[i];
-        if (solution[i])
-        {
-            origin_conf_change_in_solution[i] = solution_contribution[i];
-            conf_change_in_solution[i] = 0;
-            conf_change_timestamp[i] = 0;
-        }
-        else
+        for (int i = begin; i < end; i++)
         {
-            origin_conf_change_out_of_solution[i] = solution_contribution[i];
-            conf_change_out_of_solution[i] = 0;
-            conf_change_timestamp[i] = 0;
+            r_sum[i] = r(i);
+            select_times[i] = solution[i];
+            if (solution[i])
+            {
+                origin_conf_change_in_solution[i] = solution_contribution[i];
+                conf_change_in_solution[i] = 0;
+                conf_change_timestamp[i] = 0;
+            }
+            else
+            {
+                origin_conf_change_out_of_solution[i] = solution_contribution[i];
+                conf_change_out_of_solution[i] = 0;
+                conf_change_timestamp[i] = 0;
+            }
         }
-    }
+    });
+    Build_Arms();
+    Build_Removal_Heap();
 
     int iter = 0;
-    while (iter < Imax1)
+    while (iter < Imax1 && !Poll_Stop(iter))
     {
         if (solution_weight_sum > g->C)
         {
             //select an item in solution with the lowest density
-            int ustar = -1;
-            int ustar_idx = -1;
-            for (int i = 0; i < in_solution.size(); i++)
+            int ustar = removal_heap.first([this, iter](const int item)
             {
-                int item = in_solution[i];
-                if (conf_change_in_solution[item] > origin_conf_change_in_solution[item] * lambda &&
-                    iter < conf_change_timestamp[item])
-                    continue;
-                if (ustar == -1 || solution_contribution[item] * g->weight[ustar] <
-                                   solution_contribution[ustar] * g->weight[item])
-                {
-                    ustar = item;
-                    ustar_idx = i;
-                }
-            }
+                return conf_change_in_solution[item] > origin_conf_change_in_solution[item] * lambda &&
+                       iter < conf_change_timestamp[item];
+            });
             if (ustar != -1)
             {
-                in_solution.erase(ustar_idx);
+                Erase_In_Solution(removal_heap.order(ustar));
                 Remove_Item_With_Conf_Change(ustar, iter);
             }
         }
@@ -312,56 +766,30 @@ void BMCP::BMCPSolver::CC_Search()
 
         if (solution_weight_sum <= g->C)
         {
-            int randnum = rand() % 100;
+            int randnum = random.next() % 100;
             if (randnum < 50) // direct select
             {
-                random_list.clear();
-                for (int i = 1; i <= g->m; i++)
-                {
-                    if (solution[i]) continue;
-                    if (solution_contribution[i] == 0) continue;
-                    random_list.push_back(i);
-                }
-                int idx = Multiple_Selections(15);
+                int idx = Multiple_Selections(candidates, 15);
                 int ustar = -1;
                 for (int i = 0; i <= idx; i++)
                 {
-                    int item = random_list[i];
-                    if (ustar == -1 || solution_contribution[item] * g->weight[ustar] >
-                                       solution_contribution[ustar] * g->weight[item])
+                    int item = candidates[i];
+                    if (ustar == -1 || Denser(item, ustar))
                         ustar = item;
                 }
                 if (ustar != -1)
                 {
-                    in_solution.insert(ustar);
+                    Insert_In_Solution(ustar);
                     Add_Item_With_Conf_Change(ustar, iter);
                 }
             }
             else
             {
                 bandit_count++;
-                int ustar = -1;
-                double ustar_ucb;
-                double tmp_ucb;
-                for (int i = 1; i <= g->m; i++)
-                {
-                    if (solution[i]) continue;
-                    if (solution_contribution[i] == 0) continue;
-                    if (ustar == -1)
-                    {
-                        ustar = i;
-                        ustar_ucb = Upper_Confidence_Bound(ustar);
-                        continue;
-                    }
-                    if ((tmp_ucb = Upper_Confidence_Bound(i)) > ustar_ucb)
-                    {
-                        ustar = i;
-                        ustar_ucb = tmp_ucb;
-                    }
-                }
+                int ustar = Select_Arm();
                 if (ustar != -1)
                 {
-                    in_solution.insert(ustar);
+                    Insert_In_Solution(ustar);
                     r_sum[ustar] += r(ustar);
                     select_times[ustar]++;
                     Add_Item_With_Conf_Change(ustar, iter);
@@ -376,10 +804,47 @@ void BMCP::BMCPSolver::CC_Search()
         }
         iter++;
     }
+    removal_indexed = false;
+}
+
+template<typename Numeric>
+bool BMCP::BMCPSolver<Numeric>::Best_Swap(const int iter, int &drop, int &add)
+{
+    value best_gain = 0;
+    drop = add = -1;
+    for (int sample = 0; sample < swap_samples && !candidates.empty(); sample++)
+    {
+        int v = candidates[random.next() % candidates.size()];
+        bool v_tabu = iter < tabu_list[v];
+        //zero-profit elements add nothing, so a nonzero swap_shared marks the owners seen
+        for (int elem_nei: g->item_neighbor[v])
+        {
+            if (solution_elements[elem_nei] != 1 || g->profit[elem_nei] == 0) continue;
+            int u = solution_owner[elem_nei];
+            if (swap_shared[u] == 0) swap_owners.push_back(u);
+            swap_shared[u] += g->profit[elem_nei];
+        }
+        for (int u: swap_owners)
+        {
+            value gain = solution_contribution[v] - solution_contribution[u] + swap_shared[u];
+            swap_shared[u] = 0;
+            if (gain <= best_gain || block_list[u] || iter < tabu_list[u]) continue;
+            if (solution_weight_sum - g->weight[u] + g->weight[v] > g->C) continue;
+            //a tabu item only comes back by aspiration
+            if (v_tabu && solution_profit_sum + gain <= best_solution_profit_sum) continue;
+            best_gain = gain;
+            drop = u;
+            add = v;
+        }
+        swap_owners.clear();
+    }
+    return drop != -1;
 }
 
-void BMCP::BMCPSolver::Deep_Optimize()
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Deep_Optimize()
 {
+    BMCP_STAT(PhaseScope scope(stats, phase_deep_optimize));
     Solution_To_Best_Solution();
 
     //init block_list
@@ -408,15 +873,14 @@ void BMCP::BMCPSolver::Deep_Optimize()
                 ustar = item_nei;
                 continue;
             }
-            if (solution_contribution[item_nei] * g->weight[ustar] >
-                solution_contribution[ustar] * g->weight[item_nei])
+            if (Denser(item_nei, ustar))
                 ustar = item_nei;
         }
         if (ustar != -1)
         {
             if (block_weight_sum + g->weight[ustar] > g->C) continue;
             Add_Item(ustar);
-            in_solution.insert(ustar);
+            Insert_In_Solution(ustar);
             block_list[ustar] = 1;
             block_weight_sum += g->weight[ustar];
         }
@@ -426,36 +890,55 @@ void BMCP::BMCPSolver::Deep_Optimize()
     {
         tabu_list[i] = 0;
     }
+    optimize_tabu.clear();
+
+    //index the items out of solution by density, unless the last indexed run showed that
+    //the index costs more than the scan; probe it again every index_probe_period runs
+    if (!optimize_indexed && --optimize_probe <= 0)
+        optimize_indexed = true;
+    optimize_heap.clear();
+    optimize_pushes = 0;
+    if (optimize_indexed)
+    {
+        BMCP_STAT(stats.current().scans++);
+        for (int i = 1; i <= g->m; i++)
+        {
+            if (solution[i]) continue;
+            optimize_heap.push(solution_contribution[i], g->weight[i], i);
+        }
+    }
+    Build_Removal_Heap();
+
     int iter = 0;
-    while (iter < Imax2)
+    while (iter < Imax2 && !Poll_Stop(iter))
     {
+        if (optimize_indexed) Expire_Tabu(iter);
+        int ustar = -1;
         if (solution_weight_sum < g->C)
+            ustar = optimize_indexed ? Best_Addable(iter) : Scan_Addable(iter);
+        int drop, add;
+        //an add that overflows C or gains nothing gives way to an improving swap
+        if (swap_samples > 0 && solution_weight_sum <= g->C &&
+            (ustar == -1 || solution_weight_sum + g->weight[ustar] > g->C || solution_contribution[ustar] == 0) &&
+            Best_Swap(iter, drop, add))
         {
-            int ustar = -1;
-            for (int i = 1; i <= g->m; i++)
-            {
-                if (solution[i]) continue;
-                if (solution_profit_sum + solution_contribution[i] > best_solution_profit_sum &&
-                    solution_weight_sum + g->weight[i] <= g->C)
-                {
-                    if (ustar == -1 ||
-                        solution_contribution[i] * g->weight[ustar] >
-                        solution_contribution[ustar] * g->weight[i])
-                        ustar = i;
-                    continue;
-                }
-                if (iter < tabu_list[i]) continue;
-                if (ustar == -1 ||
-                    solution_contribution[i] * g->weight[ustar] >
-                    solution_contribution[ustar] * g->weight[i])
-                    ustar = i;
-            }
-            if (ustar != -1)
-            {
-                Add_Item(ustar);
-                in_solution.insert(ustar);
-                tabu_list[ustar] = iter + rand_deviation(tabu_length2);
-            }
+            int drop_idx = removal_heap.order(drop);
+            if (optimize_indexed)
+                Remove_Item<true>(drop);
+            else
+                Remove_Item(drop);
+            Erase_In_Solution(drop_idx);
+            Add_Item(add);
+            Insert_In_Solution(add);
+            Set_Tabu(drop, iter);
+            Set_Tabu(add, iter);
+            if (optimize_indexed) Push_Changes(iter);
+        }
+        else if (ustar != -1)
+        {
+            Add_Item(ustar);
+            Insert_In_Solution(ustar);
+            Set_Tabu(ustar, iter);
         }
         if (solution_weight_sum <= g->C && solution_profit_sum > best_solution_profit_sum)
         {
@@ -463,26 +946,20 @@ void BMCP::BMCPSolver::Deep_Optimize()
         }
         if (solution_weight_sum >= g->C)
         {
-            int ustar = -1;
-            int ustar_idx;
-            for (int i = 0; i < in_solution.size(); i++)
+            int ustar = removal_heap.first([this, iter](const int item)
             {
-                int item = in_solution[i];
-                if (block_list[item]) continue;
-                if (iter < tabu_list[item]) continue;
-                if (ustar == -1 ||
-                    solution_contribution[item] * g->weight[ustar] <
-                    solution_contribution[ustar] * g->weight[item])
-                {
-                    ustar = item;
-                    ustar_idx = i;
-                }
-            }
+                return block_list[item] || iter < tabu_list[item];
+            });
             if (ustar != -1)
             {
-                Remove_Item(ustar);
-                in_solution.erase(ustar_idx);
-                tabu_list[ustar] = iter + rand_deviation(tabu_length2);
+                int ustar_idx = removal_heap.order(ustar);
+                if (optimize_indexed)
+                    Remove_Item<true>(ustar);
+                else
+                    Remove_Item(ustar);
+                Erase_In_Solution(ustar_idx);
+                Set_Tabu(ustar, iter);
+                if (optimize_indexed) Push_Changes(iter);
             }
         }
         if (solution_weight_sum <= g->C && solution_profit_sum > best_solution_profit_sum)
@@ -491,10 +968,186 @@ void BMCP::BMCPSolver::Deep_Optimize()
         }
         iter++;
     }
+    removal_indexed = false;
+    if (optimize_indexed && optimize_pushes * index_push_cost > (ll) g->m * Imax2)
+    {
+        optimize_indexed = false;
+        optimize_probe = index_probe_period;
+    }
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Build_Removal_Heap()
+{
+    removal_heap.clear();
+    for (int i = 0; i < in_solution.size(); i++)
+    {
+        int item = in_solution[i];
+        removal_heap.insert(item, solution_contribution[item], g->weight[item], i);
+    }
+    removal_indexed = true;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Insert_In_Solution(const int item)
+{
+    if (removal_indexed)
+        removal_heap.insert(item, solution_contribution[item], g->weight[item], in_solution.size());
+    in_solution.insert(item);
+    if (journaling) Journal(journal_insert, item);
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Erase_In_Solution(const int idx)
+{
+    int item = in_solution[idx];
+    in_solution.erase(idx);
+    if (removal_indexed)
+    {
+        removal_heap.erase(item);
+        if (idx < in_solution.size())
+            removal_heap.reorder(in_solution[idx], idx);
+    }
+    if (journaling) Journal(journal_erase, item, idx);
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Set_Tabu(const int item, const int iter)
+{
+    if (optimize_indexed && tabu_list[item] <= iter)
+        optimize_tabu.push_back(item);
+    tabu_list[item] = iter + rand_deviation(tabu_length2);
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Expire_Tabu(const int iter)
+{
+    for (int i = 0; i < optimize_tabu.size();)
+    {
+        int item = optimize_tabu[i];
+        if (iter < tabu_list[item])
+        {
+            i++;
+            continue;
+        }
+        std::swap(optimize_tabu[i], optimize_tabu.back());
+        optimize_tabu.pop_back();
+        if (!solution[item])
+            Index_Item(item);
+    }
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Push_Changes(const int iter)
+{
+    //contributions only grow on removal; tabu items are queued when they expire
+    for (int item: changed_items)
+    {
+        changed_mark[item] = 0;
+        if (solution[item]) continue;
+        if (iter < tabu_list[item]) continue;
+        Index_Item(item);
+    }
+    changed_items.clear();
+}
+
+template<typename Numeric>
+int BMCP::BMCPSolver<Numeric>::Scan_Addable(const int iter)
+{
+    BMCP_STAT(stats.current().scans++);
+    //every part keeps its first densest item, so taking a later part's item only when it is
+    //strictly denser gives the sequential answer
+    int parts = For_Item_Parts([this, iter](const int t, const int begin, const int end)
+    {
+        part_best[t] = Scan_Addable(iter, begin, end);
+    });
+    int ustar = -1;
+    for (int t = 0; t < parts; t++)
+    {
+        int item = part_best[t];
+        if (item != -1 && (ustar == -1 || Denser(item, ustar)))
+            ustar = item;
+    }
+    return ustar;
+}
+
+template<typename Numeric>
+int BMCP::BMCPSolver<Numeric>::Scan_Addable(const int iter, const int begin, const int end)
+{
+    int ustar = -1;
+    for (int i = begin; i < end; i++)
+    {
+        if (solution[i]) continue;
+        if (solution_profit_sum + solution_contribution[i] > best_solution_profit_sum &&
+            solution_weight_sum + g->weight[i] <= g->C)
+        {
+            if (ustar == -1 || Denser(i, ustar))
+                ustar = i;
+            continue;
+        }
+        if (iter < tabu_list[i]) continue;
+        if (ustar == -1 || Denser(i, ustar))
+            ustar = i;
+    }
+    return ustar;
 }
 
-void BMCP::BMCPSolver::Restart()
+template<typename Numeric>
+int BMCP::BMCPSolver<Numeric>::Best_Addable(const int iter)
 {
+    //best non-tabu item: entries of items in solution or tabu are dropped, an entry above
+    //the current contribution (lowered by Add_Item) is replaced by the current one
+    int ustar = -1;
+    while (!optimize_heap.empty())
+    {
+        RatioHeap::Entry top = optimize_heap.top();
+        int i = top.id;
+        if (solution[i] || iter < tabu_list[i])
+        {
+            optimize_heap.pop();
+            continue;
+        }
+        if (top.contribution != solution_contribution[i])
+        {
+            optimize_heap.pop();
+            if (top.contribution > solution_contribution[i])
+                Index_Item(i);
+            continue;
+        }
+        ustar = i;
+        break;
+    }
+
+    //tabu items are only allowed by aspiration
+    for (int i: optimize_tabu)
+    {
+        if (solution[i]) continue;
+        if (solution_profit_sum + solution_contribution[i] <= best_solution_profit_sum ||
+            solution_weight_sum + g->weight[i] > g->C)
+            continue;
+        if (ustar == -1)
+        {
+            ustar = i;
+            continue;
+        }
+        wide lhs = (wide) solution_contribution[i] * g->weight[ustar];
+        wide rhs = (wide) solution_contribution[ustar] * g->weight[i];
+        if (lhs > rhs || (lhs == rhs && i < ustar))
+            ustar = i;
+    }
+    return ustar;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Restart()
+{
+    BMCP_STAT(PhaseScope scope(stats, phase_restart));
+    //the restart and the solutions loaded by Adopt_Shared / Migrate replace the state in bulk
+    //and CC_Search takes its result as the new best, so best is not restored before that:
+    //stop journaling until Solution_To_Best_Solution arms it again
+    journaling = false;
+    if (adopt_shared) Adopt_Shared();
+    if (inbox != nullptr) Migrate();
     int erase_cnt = 0;
     while (erase_cnt < remove_size && solution_weight_sum > 0)
     {
@@ -511,61 +1164,99 @@ void BMCP::BMCPSolver::Restart()
         }
         if (ustar != -1)
         {
-            in_solution.erase(ustar_idx);
+            Erase_In_Solution(ustar_idx);
             Remove_Item(ustar);
             erase_cnt++;
         }
     }
 }
 
-void BMCP::BMCPSolver::Start_Clock()
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Start_Clock()
 {
-    start_time = clock();
+    start_time = std::chrono::steady_clock::now();
 }
 
-int BMCP::BMCPSolver::Get_Time()
+template<typename Numeric>
+double BMCP::BMCPSolver<Numeric>::Get_Time()
 {
-    now_time = clock();
-    return now_time - start_time;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
 }
 
-void BMCP::BMCPSolver::Solve()
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Set_Stop_Criteria(const StopCriteria &stop)
 {
-    Start_Clock();
-    Greedy_Initialization();
-    if (solution_profit_sum > star_solution_profit_sum)
+    criteria = stop;
+}
+
+template<typename Numeric>
+bool BMCP::BMCPSolver<Numeric>::Check_Stop()
+{
+    if (stopping) return true;
+    double now = Get_Time();
+    ll known = std::max<ll>(star_solution_profit_sum, best_solution_profit_sum);
+    if (shared != nullptr)
     {
-        Solution_To_Star_Solution();
-        printf("%lf %d %d\n", 1.0 * Get_Time() / CLOCKS_PER_SEC, total_iterations, star_solution_profit_sum);
+        const SharedStar::Snapshot *published = shared->Load();
+        if (published != nullptr) known = std::max(known, published->profit);
     }
-    while (Get_Time() < time_limit * CLOCKS_PER_SEC)
+    stopping = stop_requested.load(std::memory_order_relaxed) || now >= time_limit ||
+               (criteria.target >= 0 && known >= criteria.target) ||
+               (criteria.stagnation > 0 && now - star_solution_time >= criteria.stagnation);
+    return stopping;
+}
+
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Solve()
+{
+    Start_Clock();
+    BMCP_STAT(stats = SolverStats());
+    anytime = true;
+    stopping = false;
+    star_solution_time = 0;
+    trace.clear();
+    if (initial_solution.empty())
+        Greedy_Initialization();
+    else
+        Warm_Start();
+    Improve_Star(phase_greedy);
+    //a stop inside a phase ends the phase early, its best solution still counts
+    while (!Check_Stop())
     {
 
         total_iterations++;
         /* ConfChange Search */
         CC_Search();
         Best_Solution_To_Solution();
-        if (solution_profit_sum > star_solution_profit_sum)
-        {
-            Solution_To_Star_Solution();
-            printf("%lf %d %d\n", 1.0 * Get_Time() / CLOCKS_PER_SEC, total_iterations, star_solution_profit_sum);
-        }
+        Improve_Star(phase_cc_search);
+        if (stopping) break;
         /* DeepOpt */
         Deep_Optimize();
         Best_Solution_To_Solution();
-        if (solution_profit_sum > star_solution_profit_sum)
-        {
-            Solution_To_Star_Solution();
-            printf("%lf %d %d\n", 1.0 * Get_Time() / CLOCKS_PER_SEC, total_iterations, star_solution_profit_sum);
-        }
+        Improve_Star(phase_deep_optimize);
+        if (stopping) break;
         Restart();
-        //printf("%lf %d %d\n", 1.0 * Get_Time() / CLOCKS_PER_SEC, total_iterations, star_solution_profit_sum);
-        fflush(stdout);
     }
+    BMCP_STAT(stats.enter(phase_solve));
 }
 
-int BMCP::BMCPSolver::rand_deviation(int num)
+template<typename Numeric>
+int BMCP::BMCPSolver<Numeric>::rand_deviation(int num)
 {
     int tmp1 = std::max(1, (int) (0.5 * num));
-    return num + (rand() % tmp1 - tmp1 / 2);
+    return num + (random.next() % tmp1 - tmp1 / 2);
 }
+
+template void BMCP::BMCPSolver<BMCP::Value32Count16>::Remove_Item<false>(int);
+template void BMCP::BMCPSolver<BMCP::Value32Count16>::Remove_Item<true>(int);
+template void BMCP::BMCPSolver<BMCP::Value32Count32>::Remove_Item<false>(int);
+template void BMCP::BMCPSolver<BMCP::Value32Count32>::Remove_Item<true>(int);
+template void BMCP::BMCPSolver<BMCP::Value64Count16>::Remove_Item<false>(int);
+template void BMCP::BMCPSolver<BMCP::Value64Count16>::Remove_Item<true>(int);
+template void BMCP::BMCPSolver<BMCP::Value64Count32>::Remove_Item<false>(int);
+template void BMCP::BMCPSolver<BMCP::Value64Count32>::Remove_Item<true>(int);
+
+template class BMCP::BMCPSolver<BMCP::Value32Count16>;
+template class BMCP::BMCPSolver<BMCP::Value32Count32>;
+template class BMCP::BMCPSolver<BMCP::Value64Count16>;
+template class BMCP::BMCPSolver<BMCP::Value64Count32>;
@@ -5,75 +5,201 @@
 #include <Graph.hpp>
 #include <SetList.hpp>
 #include <QueueList.hpp>
-#include <ctime>
+#include <IndexedSetList.hpp>
+#include <GroupedMaxSet.hpp>
+#include <DensityHeap.hpp>
+#include <RatioHeap.hpp>
+#include <Numeric.hpp>
+#include <Random.hpp>
+#include <WorkerPool.hpp>
+#include <Parallel.hpp>
+#include <Control.hpp>
+#include <Stats.hpp>
+#include <Trace.hpp>
+#include <chrono>
 #include <random>
+#include <vector>
 
 namespace BMCP
 {
     using ll = long long;
 
+    class SharedStar;
+
+    //Numeric picks the types of the accumulated values and counters, see Numeric.hpp
+    template<typename Numeric>
     class BMCPSolver
     {
+        friend class MoveBench;
+        friend class SnapshotBench;
+        friend class KernelBench;
+
+        using value = typename Numeric::value;
+        using count = typename Numeric::count;
+        using wide = typename Numeric::wide;
+
     private:
         Graph *g;
 
         //random list
         IntList random_list;
+        Random random;
 
         //solution
-        int solution_weight_sum;
-        int solution_profit_sum;
+        value solution_weight_sum;
+        value solution_profit_sum;
         int *solution;
         int solution_size;
-        int *solution_contribution;
-        int *solution_elements;
+        value *solution_contribution;
+        count *solution_elements;
+        //xor of the ids of the items in solution covering each element, so the only cover of
+        //an element covered once is read directly instead of searched in element_neighbor
+        int *solution_owner;
         SetList in_solution;
 
+        //in_solution by density, ties by position in in_solution; kept in sync with the
+        //contribution updates while removal_indexed is set (CC_Search and Deep_Optimize)
+        DensityHeap removal_heap;
+        bool removal_indexed;
+
+        void Build_Removal_Heap();
+
+        void Insert_In_Solution(int);
+
+        void Erase_In_Solution(int);
+
+        //items out of solution with nonzero contribution, kept up to date by the update functions
+        IndexedSetList candidates;
+
+        void Build_Candidates();
+
+        void Pool_Insert(int);
+
+        void Pool_Remove(int);
+
         //best_solution
-        int best_solution_weight_sum;
-        int best_solution_profit_sum;
+        value best_solution_weight_sum;
+        value best_solution_profit_sum;
         int *best_solution;
         int best_solution_size;
-        int *best_solution_contribution;
-        int *best_solution_elements;
+        value *best_solution_contribution;
+        count *best_solution_elements;
+        int *best_solution_owner;
         SetList in_best_solution;
 
         //Set Time
-        clock_t start_time;
-        clock_t now_time;
+        std::chrono::steady_clock::time_point start_time;
         int time_limit;
 
         void Start_Clock();
 
-        int Get_Time();
+        //wall-clock seconds since Start_Clock
+        double Get_Time();
+
+        //stop control: Check_Stop tests the time limit, stop_requested and the stop criteria
+        //and latches the answer in stopping; the search loops call it every control_period
+        //iterations through Poll_Stop, only while Solve runs (anytime) so phases driven
+        //directly run to their iteration limits
+        StopCriteria criteria;
+        bool anytime;
+        bool stopping;
+        static constexpr int control_period = 16;
 
-        //update solution
+        bool Check_Stop();
+
+        bool Poll_Stop(int iter);
+
+        //update solution. Dense instances use the same lists: iterating a bitset of the items of
+        //an element AND NOT a bitset of the solution measured no faster, the contribution writes
+        //dominate and few moves start or end the coverage of an element
         void Add_Item(int);
 
+        //note = true records the items whose contribution grew in changed_items
+        template<bool note = false>
         void Remove_Item(int);
 
         void Add_Item_With_Conf_Change(int, int);
 
         void Remove_Item_With_Conf_Change(int, int);
 
-        static int rand_deviation(int);
+        int rand_deviation(int);
 
         //transmit
         void Solution_To_Best_Solution();
 
-        void Solution_To_Star_Solution();
+        //false when the star is shared and another solver already has a better one
+        bool Solution_To_Star_Solution();
 
         void Best_Solution_To_Solution();
 
+        //take the solution as star if it is better, recording the improvement in trace and
+        //passing it to improvement_callback; no stdio on the way
+        ImprovementTrace trace;
+        ImprovementCallback improvement_callback;
+
+        void Improve_Star(Phase);
+
+        //best_solution as an undo log: instead of copying the arrays on every new best, the
+        //moves made since are journaled and rolled back on restore. Once the journal costs
+        //more than a copy, best is checkpointed into the best_solution arrays
+        enum
+        {
+            journal_add, journal_remove, journal_insert, journal_erase
+        };
+        struct JournalEntry
+        {
+            int type;
+            int item;
+            int idx;
+        };
+        std::vector<JournalEntry> journal;
+        bool journaling;
+        bool journal_snapshots = true;
+        bool best_in_arrays;
+        ll journal_cost;
+        ll snapshot_copies;
+        ll snapshot_rollbacks;
+
+        void Journal(int, int, int = 0);
+
+        void Start_Journal();
+
+        void Roll_Back();
+
+        void Checkpoint_Best();
+
+        //Add_Item / Remove_Item on the best_solution arrays
+        void Toggle_Best(int);
+
+        //items whose solution_contribution or membership changed since the last drain
+        IntList changed_items;
+        int *changed_mark;
+
+        void Note_Change(int);
+
+        //note the items changed by the last Add_Item or Remove_Item of an item
+        void Note_Move(int);
+
         //initialize greedily
+        RatioHeap greedy_heap;
+        IntList greedy_deferred;
+
+        bool Drain_Changes();
+
         void Greedy_Initialization();
 
+        //start from initial_solution instead: load it and, if it is over capacity, drop the
+        //least dense items until it fits
+        std::vector<int> initial_solution;
+
+        void Warm_Start();
+
         //local search (cc)
         int Imax1;
-        int *conf_change_out_of_solution;
-        int *origin_conf_change_out_of_solution;
-        int *conf_change_in_solution;
-        int *origin_conf_change_in_solution;
+        value *conf_change_out_of_solution;
+        value *origin_conf_change_out_of_solution;
+        value *conf_change_in_solution;
+        value *origin_conf_change_in_solution;
         int *conf_change_timestamp;
         int tabu_length1 = 5;
         double lambda;
@@ -86,8 +212,24 @@ namespace BMCP
 
         double Upper_Confidence_Bound(int);
 
+        //the candidates as bandit arms, grouped by max(1, select_times) and ordered by
+        //average reward; arms_dirty holds the items whose pool membership changed since
+        //the last sync
+        GroupedMaxSet arms;
+        IntList arms_dirty;
+        int *arms_dirty_mark;
+
+        void Build_Arms();
+
+        void Sync_Arms();
+
+        //the out-of-solution item with the highest Upper_Confidence_Bound, lowest id on ties
+        int Select_Arm();
+
         int Multiple_Selections(int);
 
+        int Multiple_Selections(IndexedSetList &, int);
+
         void CC_Search();
 
         //deep-optimization
@@ -99,22 +241,95 @@ namespace BMCP
         double gamma = 1;
         int bandit_count;
 
+        //the items out of solution by density, lazily: an entry may be above the item's
+        //current contribution, never below it unless a later entry holds the current one
+        RatioHeap optimize_heap;
+        //items made tabu and not yet expired
+        IntList optimize_tabu;
+        //the heap is only worth it while its pushes stay well below m per iteration;
+        //one push costs about index_push_cost scanned items
+        bool optimize_indexed = true;
+        int optimize_probe = 0;
+        ll optimize_pushes;
+        static constexpr int index_push_cost = 32;
+        static constexpr int index_probe_period = 16;
+
+        void Index_Item(int);
+
+        void Set_Tabu(int, int);
+
+        void Expire_Tabu(int);
+
+        void Push_Changes(int);
+
+        //contribution density of a above that of b
+        bool Denser(int a, int b) const;
+
+        //the item the add step of Deep_Optimize picks, -1 if none
+        int Best_Addable(int);
+
+        int Scan_Addable(int);
+
+        int Scan_Addable(int, int begin, int end);
+
+        //1-1 swaps: drop an item u in solution and add an item v out of it in one move. The
+        //gain is solution_contribution[v] - solution_contribution[u] plus the profit of the
+        //elements only u covers that v covers too, found through solution_owner. Each try
+        //samples swap_samples items of candidates and pairs them with the owners they share
+        int swap_samples = 0;
+        value *swap_shared;
+        IntList swap_owners;
+
+        //the best improving swap of a sample, false if none
+        bool Best_Swap(int, int &drop, int &add);
+
         void Deep_Optimize();
 
+        //item loops split over a worker pool: part t of [1, m] always goes to worker t, and
+        //below parallel_min_items the loop stays on the calling thread
+        WorkerPool *pool = nullptr;
+        std::vector<int> part_best;
+        static constexpr int parallel_min_items = 1 << 16;
+
+        //body(t, begin, end) for every part [begin, end) of the items, returns the number of parts
+        template<typename Body>
+        int For_Item_Parts(Body body);
+
+        //portfolio: improvements go to the shared star; with adopt_shared, a solver without
+        //its own improvement for adopt_after iterations restarts from the shared star if it
+        //is better
+        SharedStar *shared = nullptr;
+        bool adopt_shared = false;
+        int adopt_after = 10;
+
+        //island model: every migration_period iterations the star goes to the inbox of one of
+        //the neighbours, and an immigrant better than the star replaces the solution
+        SharedStar *inbox = nullptr;
+        std::vector<SharedStar *> neighbours;
+        int migration_period;
+
+        //replace the solution by items
+        int *load_mark;
+
+        void Load_Solution(const std::vector<int> &);
+
+        void Adopt_Shared();
+
+        void Migrate();
+
+        BMCP_STAT(SolverStats stats;)
+
         //restart
         int remove_size = 5;
 
         void Restart();
     public:
         //star_solution
-        int star_solution_weight_sum;
-        int star_solution_profit_sum;
-        int *star_solution;
+        value star_solution_weight_sum;
+        value star_solution_profit_sum;
         int star_solution_size;
-        int *star_solution_contribution;
-        int *star_solution_elements;
         SetList in_star_solution;
-        clock_t star_solution_time;
+        double star_solution_time;
         int star_solution_iterations;
         int total_iterations;
 
@@ -126,10 +341,122 @@ namespace BMCP
 
         void Solve();
 
+        void Set_Stop_Criteria(const StopCriteria &);
+
+        //Solve starts from these items (ids of g) instead of Greedy_Initialization
+        void Set_Initial_Solution(const std::vector<int> &);
+
+        //callback runs on the solving thread for every new star solution
+        void On_Improvement(ImprovementCallback);
+
+        //the improvements of the last Solve
+        const ImprovementTrace &Trace() const;
+
+        //split the full item scans over workers, the answers stay those of the sequential run
+        void Use_Pool(WorkerPool *);
+
+        //sample 1-1 swaps in Deep_Optimize whenever the chosen add would overflow C or gains
+        //nothing; an improving swap is made instead of that add. 0 for none
+        void Use_Swaps(int samples);
+
+        //run as a member of a portfolio sharing star, see Portfolio.hpp
+        void Share(SharedStar *, bool adopt);
+
+        //run as an island with inbox, sending the star to targets every period iterations
+        void Join_Islands(SharedStar *, const std::vector<SharedStar *> &, int period);
+
         void Output() const;
 
+        //write the item ids of star_solution, numbered as in the input file
+        bool Output_Solution(const char *) const;
+
+        //write the per-phase counters as JSON, false if not built with BANDBMCP_STATS
+        bool Output_Stats(const char *) const;
+
         ~BMCPSolver();
     };
 }
 
+template<typename Numeric>
+inline void BMCP::BMCPSolver<Numeric>::Note_Change(const int item)
+{
+    if (changed_mark[item]) return;
+    changed_mark[item] = 1;
+    changed_items.push_back(item);
+}
+
+template<typename Numeric>
+inline void BMCP::BMCPSolver<Numeric>::Pool_Insert(const int item)
+{
+    candidates.insert(item);
+    if (arms_dirty_mark[item]) return;
+    arms_dirty_mark[item] = 1;
+    arms_dirty.push_back(item);
+}
+
+template<typename Numeric>
+inline void BMCP::BMCPSolver<Numeric>::Pool_Remove(const int item)
+{
+    candidates.remove(item);
+    if (arms_dirty_mark[item]) return;
+    arms_dirty_mark[item] = 1;
+    arms_dirty.push_back(item);
+}
+
+template<typename Numeric>
+inline void BMCP::BMCPSolver<Numeric>::Journal(const int type, const int item, const int idx)
+{
+    journal.push_back({type, item, idx});
+    if (type == journal_add || type == journal_remove)
+        journal_cost += g->item_neighbor[item].size();
+    if (journal_cost > g->m + g->n)
+        Checkpoint_Best();
+}
+
+template<typename Numeric>
+inline void BMCP::BMCPSolver<Numeric>::Index_Item(const int item)
+{
+    optimize_heap.push(solution_contribution[item], g->weight[item], item);
+    optimize_pushes++;
+}
+
+template<typename Numeric>
+inline bool BMCP::BMCPSolver<Numeric>::Poll_Stop(const int iter)
+{
+    if (!anytime || iter % control_period != 0) return stopping;
+    return Check_Stop();
+}
+
+template<typename Numeric>
+template<typename Body>
+inline int BMCP::BMCPSolver<Numeric>::For_Item_Parts(Body body)
+{
+    if (pool == nullptr || g->m < parallel_min_items)
+    {
+        body(0, 1, g->m + 1);
+        return 1;
+    }
+    int parts = pool->threads();
+    auto task = [this, parts, &body](const int t)
+    {
+        body(t, 1 + (int) Chunk_Begin(g->m, parts, t), 1 + (int) Chunk_Begin(g->m, parts, t + 1));
+    };
+    pool->run(task);
+    return parts;
+}
+
+template<typename Numeric>
+inline bool BMCP::BMCPSolver<Numeric>::Denser(const int a, const int b) const
+{
+    return (wide) solution_contribution[a] * g->weight[b] > (wide) solution_contribution[b] * g->weight[a];
+}
+
+namespace BMCP
+{
+    extern template class BMCPSolver<Value32Count16>;
+    extern template class BMCPSolver<Value32Count32>;
+    extern template class BMCPSolver<Value64Count16>;
+    extern template class BMCPSolver<Value64Count32>;
+}
+
 #endif //BANDBMCP_BMCP_HPP
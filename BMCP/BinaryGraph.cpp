@@ -0,0 +1,195 @@
+#include <BinaryGraph.hpp>
+#include <MappedFile.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+namespace
+{
+    const char binary_magic[8] = {'B', 'M', 'C', 'P', 'G', 'R', 'P', 'H'};
+    const uint32_t binary_version = 1;
+    const uint32_t binary_byte_order = 0x01020304;
+
+    uint64_t Align(uint64_t pos)
+    {
+        return (pos + 63) & ~(uint64_t) 63;
+    }
+
+    //section offsets for a graph of the given shape
+    void Layout(BMCP::BinaryHeader &header)
+    {
+        uint64_t pos = Align(sizeof(BMCP::BinaryHeader));
+        header.weight = pos;
+        pos = Align(pos + sizeof(int32_t) * (header.m + 1));
+        header.profit = pos;
+        pos = Align(pos + sizeof(int32_t) * (header.n + 1));
+        header.item_offset = pos;
+        pos = Align(pos + sizeof(int64_t) * (header.m + 2));
+        header.item_index = pos;
+        pos = Align(pos + sizeof(int32_t) * header.edges);
+        header.element_offset = pos;
+        pos = Align(pos + sizeof(int64_t) * (header.n + 2));
+        header.element_index = pos;
+        pos = pos + sizeof(int32_t) * header.edges;
+        header.file_size = pos;
+    }
+
+    [[noreturn]] void Fail(const char *file_path, const char *what)
+    {
+        fprintf(stderr, "fail to load %s: %s\n", file_path, what);
+        exit(1);
+    }
+
+    //offsets start at 0, never decrease and end at edges; every id is in [1, columns] and
+    //appears at most once per row
+    bool Valid_Adjacency(const int rows, const long long *offset, const int32_t *index, const int columns,
+                         const long long edges, std::vector<int> &seen)
+    {
+        if (offset[0] != 0 || offset[1] != 0 || offset[rows + 1] != edges) return false;
+        for (int r = 1; r <= rows; r++)
+        {
+            if (offset[r + 1] < offset[r]) return false;
+        }
+        seen.assign(columns + 1, 0);
+        for (int r = 1; r <= rows; r++)
+        {
+            for (long long k = offset[r]; k < offset[r + 1]; k++)
+            {
+                int column = index[k];
+                if (column < 1 || column > columns || seen[column] == r) return false;
+                seen[column] = r;
+            }
+        }
+        return true;
+    }
+
+    uint64_t Edge_Hash(const uint64_t item, const uint64_t element)
+    {
+        uint64_t z = (item << 32 | element) * 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 29)) * 0xbf58476d1ce4e5b9ULL;
+        return z ^ (z >> 32);
+    }
+
+    //both directions hold the same edges: equal row sizes per element and an equal sum of
+    //edge hashes; with no repeated ids in a row this catches any edge present on one side only
+    bool Same_Edges(const int m, const int n, const long long *item_offset, const int32_t *item_index,
+                    const long long *element_offset, const int32_t *element_index, std::vector<int> &degree)
+    {
+        degree.assign(n + 1, 0);
+        uint64_t item_side = 0, element_side = 0;
+        for (int i = 1; i <= m; i++)
+        {
+            for (long long k = item_offset[i]; k < item_offset[i + 1]; k++)
+            {
+                degree[item_index[k]]++;
+                item_side += Edge_Hash(i, item_index[k]);
+            }
+        }
+        for (int j = 1; j <= n; j++)
+        {
+            if (element_offset[j + 1] - element_offset[j] != degree[j]) return false;
+            for (long long k = element_offset[j]; k < element_offset[j + 1]; k++)
+                element_side += Edge_Hash(element_index[k], j);
+        }
+        return item_side == element_side;
+    }
+
+    bool Write_At(FILE *file, uint64_t pos, const void *data, size_t bytes)
+    {
+        if (fseek(file, (long) pos, SEEK_SET) != 0) return false;
+        return bytes == 0 || fwrite(data, 1, bytes, file) == bytes;
+    }
+
+    bool Write_Adjacency(FILE *file, uint64_t offset_pos, uint64_t index_pos, const BMCP::CSRList &list)
+    {
+        return Write_At(file, offset_pos, list.offset(), sizeof(int64_t) * (list.rows() + 2)) &&
+               Write_At(file, index_pos, list.index(), sizeof(int32_t) * list.edges());
+    }
+}
+
+BMCP::Graph *BMCP::Input_From_Binary(const char *file_path)
+{
+    MappedFile file;
+    if (!file.open(file_path))
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        exit(1);
+    }
+    BinaryHeader header{};
+    if (file.size() < sizeof(BinaryHeader)) Fail(file_path, "not a graph image");
+    memcpy(&header, file.data(), sizeof(BinaryHeader));
+    if (memcmp(header.magic, binary_magic, sizeof(binary_magic)) != 0) Fail(file_path, "not a graph image");
+    if (header.version != binary_version) Fail(file_path, "unsupported version");
+    if (header.byte_order != binary_byte_order) Fail(file_path, "written with another byte order");
+    BinaryHeader expect = header;
+    if (header.m < 0 || header.n < 0 || header.edges < 0) Fail(file_path, "bad header");
+    Layout(expect);
+    if (memcmp(&expect, &header, sizeof(BinaryHeader)) != 0 || header.file_size > file.size())
+        Fail(file_path, "truncated or inconsistent image");
+
+    char *base = file.data();
+    auto *weight = (int32_t *) (base + header.weight);
+    auto *profit = (int32_t *) (base + header.profit);
+    auto *item_offset = (long long *) (base + header.item_offset);
+    auto *item_index = (int32_t *) (base + header.item_index);
+    auto *element_offset = (long long *) (base + header.element_offset);
+    auto *element_index = (int32_t *) (base + header.element_index);
+    //the arrays are used as they are, so they get the checks Finalize gives the text formats
+    std::vector<int> scratch;
+    if (!Valid_Adjacency(header.m, item_offset, item_index, header.n, header.edges, scratch) ||
+        !Valid_Adjacency(header.n, element_offset, element_index, header.m, header.edges, scratch))
+        Fail(file_path, "bad adjacency: offsets out of order, ids out of range or repeated edges");
+    if (!Same_Edges(header.m, header.n, item_offset, item_index, element_offset, element_index, scratch))
+        Fail(file_path, "item and element adjacency disagree");
+    //the checks were the sequential pass, the search looks items and elements up at random
+    file.random_access();
+
+    //the arrays are used in place, the graph keeps the mapping alive
+    Graph *g = new Graph();
+    g->m = header.m;
+    g->n = header.n;
+    g->C = header.C;
+    g->item_neighbor.attach(g->m, item_offset, item_index);
+    g->element_neighbor.attach(g->n, element_offset, element_index);
+    g->Attach(std::move(file), weight, profit);
+    return g;
+}
+
+bool BMCP::Output_To_Binary(const Graph *g, const char *file_path)
+{
+    BinaryHeader header{};
+    memcpy(header.magic, binary_magic, sizeof(binary_magic));
+    header.version = binary_version;
+    header.byte_order = binary_byte_order;
+    header.m = g->m;
+    header.n = g->n;
+    header.C = g->C;
+    header.edges = g->item_neighbor.edges();
+    Layout(header);
+
+    FILE *file = fopen(file_path, "wb");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        return false;
+    }
+    std::vector<int32_t> weight(g->weight, g->weight + g->m + 1);
+    std::vector<int32_t> profit(g->profit, g->profit + g->n + 1);
+    weight[0] = 0;
+    profit[0] = 0;
+    bool ok = Write_At(file, 0, &header, sizeof(BinaryHeader)) &&
+              Write_At(file, header.weight, weight.data(), sizeof(int32_t) * weight.size()) &&
+              Write_At(file, header.profit, profit.data(), sizeof(int32_t) * profit.size()) &&
+              Write_Adjacency(file, header.item_offset, header.item_index, g->item_neighbor) &&
+              Write_Adjacency(file, header.element_offset, header.element_index, g->element_neighbor);
+    //the alignment gap in front of an empty last section still counts
+    if (ok && (fflush(file) != 0 || ftruncate(fileno(file), (off_t) header.file_size) != 0))
+        ok = false;
+    if (fclose(file) != 0) ok = false;
+    if (!ok)
+        fprintf(stderr, "fail to write this file %s\n", file_path);
+    return ok;
+}
@@ -0,0 +1,41 @@
+#ifndef BANDBMCP_BINARYGRAPH_HPP
+#define BANDBMCP_BINARYGRAPH_HPP
+
+#include <Graph.hpp>
+#include <cstdint>
+
+namespace BMCP
+{
+    //input_type 3: flat little-endian image of a Graph, every section aligned to 64 bytes.
+    //  header
+    //  weight[m + 1]              int32
+    //  profit[n + 1]              int32
+    //  item_offset[m + 2]         int64, neighbors of item i are item_index[item_offset[i], item_offset[i + 1])
+    //  item_index[edges]          int32
+    //  element_offset[n + 2]      int64
+    //  element_index[edges]       int32
+    struct BinaryHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        int32_t m;
+        int32_t n;
+        int32_t C;
+        int32_t reserved;
+        int64_t edges;
+        uint64_t weight;
+        uint64_t profit;
+        uint64_t item_offset;
+        uint64_t item_index;
+        uint64_t element_offset;
+        uint64_t element_index;
+        uint64_t file_size;
+    };
+
+    Graph *Input_From_Binary(const char *);
+
+    bool Output_To_Binary(const Graph *, const char *);
+}
+
+#endif //BANDBMCP_BINARYGRAPH_HPP
@@ -0,0 +1,16 @@
+#include <Control.hpp>
+#include <csignal>
+
+std::atomic<bool> BMCP::stop_requested(false);
+
+static void Request_Stop(const int signal)
+{
+    BMCP::stop_requested.store(true, std::memory_order_relaxed);
+    std::signal(signal, SIG_DFL);
+}
+
+void BMCP::Install_Stop_Handlers()
+{
+    std::signal(SIGINT, Request_Stop);
+    std::signal(SIGTERM, Request_Stop);
+}
@@ -0,0 +1,25 @@
+#ifndef BANDBMCP_CONTROL_HPP
+#define BANDBMCP_CONTROL_HPP
+
+#include <atomic>
+
+namespace BMCP
+{
+    //when a solver stops besides its time limit
+    struct StopCriteria
+    {
+        //stop once a solution with at least this profit is known, -1 for none
+        long long target = -1;
+        //stop after this many seconds without a new star, 0 for none
+        double stagnation = 0;
+    };
+
+    //set by SIGINT / SIGTERM once Install_Stop_Handlers ran; solvers poll it and return
+    //their best solution
+    extern std::atomic<bool> stop_requested;
+
+    //the first SIGINT or SIGTERM sets stop_requested, a second one terminates as usual
+    void Install_Stop_Handlers();
+}
+
+#endif //BANDBMCP_CONTROL_HPP
@@ -0,0 +1,160 @@
+#include "CSRList.hpp"
+#include "Parallel.hpp"
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace
+{
+    //cache-line aligned block, released with free()
+    template<typename T>
+    T *Aligned_New(long long count)
+    {
+        size_t bytes = ((sizeof(T) * count + 63) / 64) * 64;
+        void *ptr = std::aligned_alloc(64, bytes == 0 ? 64 : bytes);
+        if (ptr == nullptr) throw std::bad_alloc();
+        return (T *) ptr;
+    }
+}
+
+BMCP::CSRList::CSRList() : _offset(nullptr), _index(nullptr), _rows(0), _owner(false) {}
+
+void BMCP::CSRList::release()
+{
+    if (_owner)
+    {
+        free(_offset);
+        free(_index);
+    }
+    _offset = nullptr;
+    _index = nullptr;
+    _rows = 0;
+    _owner = false;
+}
+
+void BMCP::CSRList::build(const int rows, const int *row, const int *column, const long long edges, int threads)
+{
+    release();
+    _rows = rows;
+    _owner = true;
+    _offset = Aligned_New<long long>(rows + 2);
+    _index = Aligned_New<int>(edges);
+    if (edges < (1 << 16)) threads = 1;
+
+    //count[t][r]: edges of row r in the t-th slice of the input, turned into the
+    //position where that slice starts writing row r, which keeps the sort stable
+    std::vector<std::vector<long long>> count(threads);
+    Run_Parallel(threads, [&](int t)
+    {
+        std::vector<long long> &local = count[t];
+        local.assign(rows + 1, 0);
+        for (long long k = Chunk_Begin(edges, threads, t); k < Chunk_Begin(edges, threads, t + 1); k++)
+            local[row[k]]++;
+    });
+    _offset[0] = 0;
+    _offset[1] = 0;
+    long long pos = 0;
+    for (int r = 1; r <= rows; r++)
+    {
+        for (int t = 0; t < threads; t++)
+        {
+            long long cnt = count[t][r];
+            count[t][r] = pos;
+            pos += cnt;
+        }
+        _offset[r + 1] = pos;
+    }
+    Run_Parallel(threads, [&](int t)
+    {
+        std::vector<long long> &cursor = count[t];
+        for (long long k = Chunk_Begin(edges, threads, t); k < Chunk_Begin(edges, threads, t + 1); k++)
+            _index[cursor[row[k]]++] = column[k];
+    });
+}
+
+long long BMCP::CSRList::unique(const int columns, int threads)
+{
+    if (edges() < (1 << 16)) threads = 1;
+    //kept[r + 1]: distinct columns of row r
+    std::vector<long long> kept(_rows + 2, 0);
+    auto for_rows = [&](int t, auto &&func)
+    {
+        std::vector<int> stamp(columns + 1, 0);
+        for (int r = (int) Chunk_Begin(_rows, threads, t) + 1; r <= Chunk_Begin(_rows, threads, t + 1); r++)
+            func(r, stamp);
+    };
+    Run_Parallel(threads, [&](int t)
+    {
+        for_rows(t, [&](int r, std::vector<int> &stamp)
+        {
+            for (long long k = _offset[r]; k < _offset[r + 1]; k++)
+            {
+                if (stamp[_index[k]] == r) continue;
+                stamp[_index[k]] = r;
+                kept[r + 1]++;
+            }
+        });
+    });
+    for (int r = 1; r <= _rows + 1; r++)
+        kept[r] += kept[r - 1];
+    long long dropped = edges() - kept[_rows + 1];
+    if (dropped == 0) return 0;
+
+    int *index = Aligned_New<int>(kept[_rows + 1]);
+    Run_Parallel(threads, [&](int t)
+    {
+        for_rows(t, [&](int r, std::vector<int> &stamp)
+        {
+            long long pos = kept[r];
+            for (long long k = _offset[r]; k < _offset[r + 1]; k++)
+            {
+                if (stamp[_index[k]] == r) continue;
+                stamp[_index[k]] = r;
+                index[pos++] = _index[k];
+            }
+        });
+    });
+    long long *offset = Aligned_New<long long>(_rows + 2);
+    for (int r = 0; r <= _rows + 1; r++)
+        offset[r] = kept[r];
+    int rows = _rows;
+    release();
+    _rows = rows;
+    _offset = offset;
+    _index = index;
+    _owner = true;
+    return dropped;
+}
+
+void BMCP::CSRList::attach(const int rows, long long *offset, int *index)
+{
+    release();
+    _rows = rows;
+    _offset = offset;
+    _index = index;
+}
+
+int BMCP::CSRList::rows() const
+{
+    return _rows;
+}
+
+long long BMCP::CSRList::edges() const
+{
+    return _offset == nullptr ? 0 : _offset[_rows + 1];
+}
+
+const long long *BMCP::CSRList::offset() const
+{
+    return _offset;
+}
+
+const int *BMCP::CSRList::index() const
+{
+    return _index;
+}
+
+BMCP::CSRList::~CSRList()
+{
+    release();
+}
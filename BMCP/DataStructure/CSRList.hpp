@@ -0,0 +1,102 @@
+#ifndef BANDBMCP_CSRLIST_HPP
+#define BANDBMCP_CSRLIST_HPP
+
+namespace BMCP
+{
+    //adjacency in compressed sparse rows, rows are numbered from 1:
+    //the neighbors of row i are index[offset[i], offset[i + 1])
+    class CSRList
+    {
+    private:
+        long long *_offset;
+        int *_index;
+        int _rows;
+        bool _owner;
+
+        void release();
+
+    public:
+        class Range
+        {
+        private:
+            const int *_begin;
+            const int *_end;
+
+        public:
+            typedef const int *const_iterator;
+
+            Range(const int *, const int *);
+
+            const_iterator begin() const;
+
+            const_iterator end() const;
+
+            int size() const;
+
+            bool empty() const;
+
+            int operator[](int) const;
+        };
+
+        CSRList();
+
+        CSRList(const CSRList &) = delete;
+
+        CSRList &operator=(const CSRList &) = delete;
+
+        //counting sort of the pairs (row[k], column[k]), keeping their order inside a row
+        void build(int rows, const int *row, const int *column, long long edges, int threads = 1);
+
+        //drop repeated columns inside a row, keeping the first occurrence, returns how many were dropped
+        long long unique(int columns, int threads = 1);
+
+        //use arrays owned by someone else, e.g. a mapped image
+        void attach(int rows, long long *offset, int *index);
+
+        int rows() const;
+
+        long long edges() const;
+
+        const long long *offset() const;
+
+        const int *index() const;
+
+        Range operator[](int) const;
+
+        ~CSRList();
+    };
+
+    inline CSRList::Range::Range(const int *begin, const int *end) : _begin(begin), _end(end) {}
+
+    inline CSRList::Range::const_iterator CSRList::Range::begin() const
+    {
+        return _begin;
+    }
+
+    inline CSRList::Range::const_iterator CSRList::Range::end() const
+    {
+        return _end;
+    }
+
+    inline int CSRList::Range::size() const
+    {
+        return _end - _begin;
+    }
+
+    inline bool CSRList::Range::empty() const
+    {
+        return _begin == _end;
+    }
+
+    inline int CSRList::Range::operator[](const int index) const
+    {
+        return _begin[index];
+    }
+
+    inline CSRList::Range CSRList::operator[](const int row) const
+    {
+        return {_index + _offset[row], _index + _offset[row + 1]};
+    }
+}
+
+#endif //BANDBMCP_CSRLIST_HPP
@@ -0,0 +1,102 @@
+#include "DensityHeap.hpp"
+
+BMCP::DensityHeap::DensityHeap(const int universe)
+{
+    _key = new Key[universe + 1];
+    _slot = new int[universe + 1];
+    _heap = new int[universe + 1];
+    _size = 0;
+    for (int i = 0; i <= universe; i++)
+        _slot[i] = -1;
+}
+
+void BMCP::DensityHeap::up(int slot)
+{
+    int id = _heap[slot];
+    while (slot > 0)
+    {
+        int parent = (slot - 1) / 2;
+        if (!less(id, _heap[parent])) break;
+        _heap[slot] = _heap[parent];
+        _slot[_heap[slot]] = slot;
+        slot = parent;
+    }
+    _heap[slot] = id;
+    _slot[id] = slot;
+}
+
+void BMCP::DensityHeap::down(int slot)
+{
+    int id = _heap[slot];
+    while (true)
+    {
+        int child = 2 * slot + 1;
+        if (child >= _size) break;
+        if (child + 1 < _size && less(_heap[child + 1], _heap[child]))
+            child++;
+        if (!less(_heap[child], id)) break;
+        _heap[slot] = _heap[child];
+        _slot[_heap[slot]] = slot;
+        slot = child;
+    }
+    _heap[slot] = id;
+    _slot[id] = slot;
+}
+
+void BMCP::DensityHeap::insert(const int id, const long long contribution, const int weight, const int order)
+{
+    _key[id] = {contribution, weight, order};
+    _heap[_size] = id;
+    _slot[id] = _size;
+    _size++;
+    up(_size - 1);
+}
+
+void BMCP::DensityHeap::erase(const int id)
+{
+    int slot = _slot[id];
+    if (slot == -1) return;
+    _slot[id] = -1;
+    _size--;
+    if (slot == _size) return;
+    int moved = _heap[_size];
+    _heap[slot] = moved;
+    _slot[moved] = slot;
+    up(slot);
+    down(_slot[moved]);
+}
+
+void BMCP::DensityHeap::reorder(const int id, const int order)
+{
+    if (_slot[id] == -1) return;
+    int old = _key[id].order;
+    _key[id].order = order;
+    if (order < old)
+        up(_slot[id]);
+    else
+        down(_slot[id]);
+}
+
+int BMCP::DensityHeap::order(const int id) const
+{
+    return _key[id].order;
+}
+
+int BMCP::DensityHeap::size() const
+{
+    return _size;
+}
+
+void BMCP::DensityHeap::clear()
+{
+    for (int i = 0; i < _size; i++)
+        _slot[_heap[i]] = -1;
+    _size = 0;
+}
+
+BMCP::DensityHeap::~DensityHeap()
+{
+    delete[] _key;
+    delete[] _slot;
+    delete[] _heap;
+}
@@ -0,0 +1,119 @@
+#ifndef BANDBMCP_DENSITYHEAP_HPP
+#define BANDBMCP_DENSITYHEAP_HPP
+
+#include <algorithm>
+#include <vector>
+
+namespace BMCP
+{
+    //indexed binary min-heap of ids in [0, universe] ordered by contribution / weight,
+    //equal densities by lower order; keys are changed in place
+    class DensityHeap
+    {
+    private:
+        struct Key
+        {
+            long long contribution;
+            int weight;
+            int order;
+        };
+
+        Key *_key;
+        int *_slot;
+        int *_heap;
+        int _size;
+        std::vector<int> _frontier;
+
+        bool less(int, int) const;
+
+        void up(int);
+
+        void down(int);
+
+    public:
+        DensityHeap(int universe);
+
+        DensityHeap(const DensityHeap &) = delete;
+
+        DensityHeap &operator=(const DensityHeap &) = delete;
+
+        bool contains(int) const;
+
+        void insert(int id, long long contribution, int weight, int order);
+
+        //no-op if absent
+        void erase(int);
+
+        //no-op if absent
+        void update(int id, long long contribution);
+
+        //no-op if absent
+        void reorder(int id, int order);
+
+        int order(int) const;
+
+        int size() const;
+
+        void clear();
+
+        //the least id for which skip is false, -1 if there is none; only the skipped ids and
+        //their children are visited
+        template<class Skip>
+        int first(Skip skip);
+
+        ~DensityHeap();
+    };
+
+    inline bool DensityHeap::less(const int a, const int b) const
+    {
+        __int128 lhs = (__int128) _key[a].contribution * _key[b].weight;
+        __int128 rhs = (__int128) _key[b].contribution * _key[a].weight;
+        if (lhs != rhs) return lhs < rhs;
+        return _key[a].order < _key[b].order;
+    }
+
+    inline bool DensityHeap::contains(const int id) const
+    {
+        return _slot[id] != -1;
+    }
+
+    inline void DensityHeap::update(const int id, const long long contribution)
+    {
+        if (_slot[id] == -1) return;
+        long long old = _key[id].contribution;
+        _key[id].contribution = contribution;
+        if (contribution < old)
+            up(_slot[id]);
+        else
+            down(_slot[id]);
+    }
+
+    template<class Skip>
+    int DensityHeap::first(Skip skip)
+    {
+        if (_size == 0) return -1;
+        //best-first walk of the heap tree, a child is only reached through its parent
+        auto later = [this](const int a, const int b)
+        {
+            return less(_heap[b], _heap[a]);
+        };
+        _frontier.clear();
+        _frontier.push_back(0);
+        while (!_frontier.empty())
+        {
+            std::pop_heap(_frontier.begin(), _frontier.end(), later);
+            int slot = _frontier.back();
+            _frontier.pop_back();
+            if (!skip(_heap[slot]))
+                return _heap[slot];
+            for (int child = 2 * slot + 1; child <= 2 * slot + 2 && child < _size; child++)
+            {
+                _frontier.push_back(child);
+                std::push_heap(_frontier.begin(), _frontier.end(), later);
+            }
+        }
+        return -1;
+    }
+}
+
+#endif //BANDBMCP_DENSITYHEAP_HPP
@@ -1,20 +1,89 @@
 #include "Graph.hpp"
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 
-BMCP::Graph::Graph(int m, int n, int C) : m(m), n(n), C(C)
+BMCP::Graph::Graph(int m, int n, int C) : owner(true), C(C), m(m), n(n), item_origin(nullptr)
 {
     weight = new int[m + 1];
     profit = new int[n + 1];
-    item_neighbor = new IntList[m + 1];
-    element_neighbor = new IntList[n + 1];
 }
 
-BMCP::Graph::Graph() {}
+BMCP::Graph::Graph() : owner(true), C(0), m(0), n(0), weight(nullptr), profit(nullptr), item_origin(nullptr) {}
+
+void BMCP::Graph::Add_Edge(int item, int element)
+{
+    edge_item.push_back(item);
+    edge_element.push_back(element);
+}
+
+long long BMCP::Graph::Finalize(int threads)
+{
+    long long edges = edge_item.size();
+    for (long long k = 0; k < edges; k++)
+    {
+        if (edge_item[k] < 1 || edge_item[k] > m || edge_element[k] < 1 || edge_element[k] > n) [[unlikely]]
+            throw std::out_of_range("Edge " + std::to_string(k + 1) + " (" + std::to_string(edge_item[k]) + ", " +
+                                    std::to_string(edge_element[k]) + ") Out of Range");
+    }
+    item_neighbor.build(m, edge_item.data(), edge_element.data(), edges, threads);
+    element_neighbor.build(n, edge_element.data(), edge_item.data(), edges, threads);
+    std::vector<int>().swap(edge_item);
+    std::vector<int>().swap(edge_element);
+    //a repeated edge would be counted twice in solution_elements
+    long long merged = item_neighbor.unique(n, threads);
+    element_neighbor.unique(m, threads);
+    return merged;
+}
+
+int BMCP::Graph::Item_Origin(int item) const
+{
+    return item_origin == nullptr ? item : item_origin[item];
+}
+
+long long BMCP::Graph::Total_Profit() const
+{
+    long long sum = 0;
+    for (int j = 1; j <= n; j++)
+        sum += profit[j];
+    return sum;
+}
+
+long long BMCP::Graph::Total_Weight() const
+{
+    long long sum = 0;
+    for (int i = 1; i <= m; i++)
+        sum += weight[i];
+    return sum;
+}
+
+int BMCP::Graph::Max_Element_Degree() const
+{
+    int degree = 0;
+    for (int j = 1; j <= n; j++)
+        degree = std::max(degree, element_neighbor[j].size());
+    return degree;
+}
+
+void BMCP::Graph::Attach(MappedFile &&file, int *weight_array, int *profit_array)
+{
+    if (owner)
+    {
+        delete[] weight;
+        delete[] profit;
+    }
+    image = std::move(file);
+    weight = weight_array;
+    profit = profit_array;
+    owner = false;
+}
 
 BMCP::Graph::~Graph()
 {
-    delete[] weight;
-    delete[] profit;
-    delete[] item_neighbor;
-    delete[] element_neighbor;
+    delete[] item_origin;
+    if (owner)
+    {
+        delete[] weight;
+        delete[] profit;
+    }
 }
@@ -1,12 +1,19 @@
 #ifndef BANDBMCP_GRAPH_HPP
 #define BANDBMCP_GRAPH_HPP
 
-#include "IntList.hpp"
+#include "CSRList.hpp"
+#include "MappedFile.hpp"
+#include <vector>
 
 namespace BMCP
 {
     class Graph
     {
+    private:
+        //image the arrays point into, if any
+        MappedFile image;
+        bool owner;
+
     public:
         //knapsack
         int C;
@@ -18,14 +25,40 @@ namespace BMCP
         int *weight;
         int *profit;
 
-        //adjacent list
-        IntList *item_neighbor;
-        IntList *element_neighbor;
+        //id of item i in the input file, nullptr while ids are unchanged
+        int *item_origin;
+
+        //edges collected before Finalize()
+        std::vector<int> edge_item;
+        std::vector<int> edge_element;
+
+        //adjacent list, valid after Finalize()
+        CSRList item_neighbor;
+        CSRList element_neighbor;
 
         Graph(int, int, int);
 
         Graph();
 
+        void Add_Edge(int, int);
+
+        //build both adjacency directions from the collected edges and merge repeated ones,
+        //returns the number of merged edges, throws std::out_of_range on a bad id
+        long long Finalize(int threads = 1);
+
+        int Item_Origin(int) const;
+
+        //sums of all profits and weights, and the most items any element has; they bound the
+        //values the solver accumulates
+        long long Total_Profit() const;
+
+        long long Total_Weight() const;
+
+        int Max_Element_Degree() const;
+
+        //take over a mapped image, weight and profit then point into it
+        void Attach(MappedFile &&, int *, int *);
+
         ~Graph();
     };
 }
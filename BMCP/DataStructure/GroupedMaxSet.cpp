@@ -0,0 +1,45 @@
+#include "GroupedMaxSet.hpp"
+
+BMCP::GroupedMaxSet::GroupedMaxSet(const int universe) : _universe(universe)
+{
+    _group = new int[universe + 1];
+    _key = new double[universe + 1];
+    for (int i = 0; i <= universe; i++)
+        _group[i] = 0;
+}
+
+void BMCP::GroupedMaxSet::insert(const int id, const int group, const double key)
+{
+    erase(id);
+    _group[id] = group;
+    _key[id] = key;
+    _groups[group].insert({key, id});
+}
+
+void BMCP::GroupedMaxSet::erase(const int id)
+{
+    if (_group[id] == 0) return;
+    auto it = _groups.find(_group[id]);
+    it->second.erase({_key[id], id});
+    if (it->second.empty())
+        _groups.erase(it);
+    _group[id] = 0;
+}
+
+void BMCP::GroupedMaxSet::clear()
+{
+    _groups.clear();
+    for (int i = 0; i <= _universe; i++)
+        _group[i] = 0;
+}
+
+const std::map<int, BMCP::GroupedMaxSet::Group> &BMCP::GroupedMaxSet::groups() const
+{
+    return _groups;
+}
+
+BMCP::GroupedMaxSet::~GroupedMaxSet()
+{
+    delete[] _group;
+    delete[] _key;
+}
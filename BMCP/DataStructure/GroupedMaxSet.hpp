@@ -0,0 +1,65 @@
+#ifndef BANDBMCP_GROUPEDMAXSET_HPP
+#define BANDBMCP_GROUPEDMAXSET_HPP
+
+#include <map>
+#include <set>
+#include <utility>
+
+namespace BMCP
+{
+    //ids in [0, universe] partitioned into integer groups; every group is ordered by a
+    //double key, larger keys first and equal keys by lower id. Keys are fixed while an
+    //id is inside: erase it, change the key and insert it again.
+    class GroupedMaxSet
+    {
+    public:
+        struct Order
+        {
+            bool operator()(const std::pair<double, int> &, const std::pair<double, int> &) const;
+        };
+
+        typedef std::set<std::pair<double, int>, Order> Group;
+
+    private:
+        std::map<int, Group> _groups;
+        int *_group;
+        double *_key;
+        int _universe;
+
+    public:
+        GroupedMaxSet(int universe);
+
+        GroupedMaxSet(const GroupedMaxSet &) = delete;
+
+        GroupedMaxSet &operator=(const GroupedMaxSet &) = delete;
+
+        bool contains(int) const;
+
+        //group must be positive
+        void insert(int id, int group, double key);
+
+        //no-op if absent
+        void erase(int);
+
+        void clear();
+
+        //non-empty groups in increasing order
+        const std::map<int, Group> &groups() const;
+
+        ~GroupedMaxSet();
+    };
+
+    inline bool GroupedMaxSet::Order::operator()(const std::pair<double, int> &a,
+                                                 const std::pair<double, int> &b) const
+    {
+        if (a.first != b.first) return a.first > b.first;
+        return a.second < b.second;
+    }
+
+    inline bool GroupedMaxSet::contains(const int id) const
+    {
+        return _group[id] != 0;
+    }
+}
+
+#endif //BANDBMCP_GROUPEDMAXSET_HPP
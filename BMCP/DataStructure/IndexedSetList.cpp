@@ -0,0 +1,21 @@
+#include "IndexedSetList.hpp"
+
+BMCP::IndexedSetList::IndexedSetList(const int universe) : IntList(universe + 1)
+{
+    _position = new int[universe + 1];
+    for (int i = 0; i <= universe; i++)
+        _position[i] = -1;
+    _end = _begin;
+}
+
+void BMCP::IndexedSetList::clear()
+{
+    for (int *it = _begin; it != _end; ++it)
+        _position[*it] = -1;
+    _end = _begin;
+}
+
+BMCP::IndexedSetList::~IndexedSetList()
+{
+    delete[] _position;
+}
@@ -0,0 +1,71 @@
+#ifndef BANDBMCP_INDEXEDSETLIST_HPP
+#define BANDBMCP_INDEXEDSETLIST_HPP
+
+#include <IntList.hpp>
+#include <algorithm>
+
+namespace BMCP
+{
+    //set of ids in [0, universe] kept as a dense list with a position map,
+    //so insert, remove and contains are O(1) by value
+    class IndexedSetList : public IntList
+    {
+    private:
+        int *_position;
+
+    public:
+        IndexedSetList(int universe);
+
+        IndexedSetList(const IndexedSetList &) = delete;
+
+        IndexedSetList &operator=(const IndexedSetList &) = delete;
+
+        bool contains(int) const;
+
+        //no-op if already present
+        void insert(int);
+
+        //no-op if absent
+        void remove(int);
+
+        //exchange the entries at two positions
+        void swap(int, int);
+
+        void clear();
+
+        ~IndexedSetList();
+    };
+
+    inline bool IndexedSetList::contains(const int obj) const
+    {
+        return _position[obj] != -1;
+    }
+
+    inline void IndexedSetList::insert(const int obj)
+    {
+        if (_position[obj] != -1) return;
+        _position[obj] = (int) (_end - _begin);
+        *_end = obj;
+        _end++;
+    }
+
+    inline void IndexedSetList::remove(const int obj)
+    {
+        int index = _position[obj];
+        if (index == -1) return;
+        int last = *(_end - 1);
+        *(_begin + index) = last;
+        _position[last] = index;
+        _position[obj] = -1;
+        _end--;
+    }
+
+    inline void IndexedSetList::swap(const int i, const int j)
+    {
+        std::swap(*(_begin + i), *(_begin + j));
+        _position[*(_begin + i)] = i;
+        _position[*(_begin + j)] = j;
+    }
+}
+
+#endif //BANDBMCP_INDEXEDSETLIST_HPP
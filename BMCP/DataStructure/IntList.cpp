@@ -146,8 +146,13 @@ BMCP::IntList &BMCP::IntList::operator=(const BMCP::IntList &list)
 {
     if(this != &list)
     {
-        this->_capacity = list._capacity;
-        this->_begin = new int[this->_capacity];
+        //reuse the buffer when it is large enough, the per-restore copies are then allocation free
+        if (this->_capacity < list.size())
+        {
+            delete[] this->_begin;
+            this->_capacity = list._capacity;
+            this->_begin = new int[this->_capacity];
+        }
         this->_end = _begin + list.size();
         for (int *it = this->_begin, *it2 = list._begin; it != this->_end; ++it, ++it2)
         {
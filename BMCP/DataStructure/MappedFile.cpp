@@ -0,0 +1,89 @@
+#include <MappedFile.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+BMCP::MappedFile::MappedFile() : _data(nullptr), _size(0) {}
+
+BMCP::MappedFile::MappedFile(BMCP::MappedFile &&file) noexcept : _data(file._data), _size(file._size)
+{
+    file._data = nullptr;
+    file._size = 0;
+}
+
+BMCP::MappedFile &BMCP::MappedFile::operator=(BMCP::MappedFile &&file) noexcept
+{
+    if (this != &file)
+    {
+        close();
+        _data = file._data;
+        _size = file._size;
+        file._data = nullptr;
+        file._size = 0;
+    }
+    return *this;
+}
+
+bool BMCP::MappedFile::open(const char *file_path)
+{
+    close();
+    int fd = ::open(file_path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    _size = st.st_size;
+    if (_size == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+    void *ptr = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (ptr == MAP_FAILED)
+    {
+        _size = 0;
+        return false;
+    }
+    madvise(ptr, _size, MADV_SEQUENTIAL);
+    _data = ptr;
+    return true;
+}
+
+void BMCP::MappedFile::random_access()
+{
+    if (_data != nullptr)
+        madvise(_data, _size, MADV_RANDOM);
+}
+
+void BMCP::MappedFile::close()
+{
+    if (_data != nullptr)
+        munmap(_data, _size);
+    _data = nullptr;
+    _size = 0;
+}
+
+const char *BMCP::MappedFile::data() const
+{
+    return (const char *) _data;
+}
+
+char *BMCP::MappedFile::data()
+{
+    return (char *) _data;
+}
+
+size_t BMCP::MappedFile::size() const
+{
+    return _size;
+}
+
+BMCP::MappedFile::~MappedFile()
+{
+    close();
+}
@@ -0,0 +1,44 @@
+#ifndef BANDBMCP_MAPPEDFILE_HPP
+#define BANDBMCP_MAPPEDFILE_HPP
+
+#include <cstddef>
+
+namespace BMCP
+{
+    //private (copy-on-write) memory mapping of a whole file
+    class MappedFile
+    {
+    private:
+        void *_data;
+        size_t _size;
+
+    public:
+        MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&) noexcept;
+
+        MappedFile &operator=(MappedFile &&) noexcept;
+
+        //the mapping is advised for one sequential pass when opened; switch to random access
+        //once that pass is over and the data is looked up in place
+        bool open(const char *);
+
+        void random_access();
+
+        void close();
+
+        const char *data() const;
+
+        char *data();
+
+        size_t size() const;
+
+        ~MappedFile();
+    };
+}
+
+#endif //BANDBMCP_MAPPEDFILE_HPP
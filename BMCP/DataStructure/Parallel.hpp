@@ -0,0 +1,28 @@
+#ifndef BANDBMCP_PARALLEL_HPP
+#define BANDBMCP_PARALLEL_HPP
+
+#include <thread>
+#include <vector>
+
+namespace BMCP
+{
+    //run func(t) for t in [0, threads), t = 0 on the calling thread
+    template<typename Func>
+    void Run_Parallel(int threads, Func func)
+    {
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++)
+            workers.emplace_back(func, t);
+        func(0);
+        for (std::thread &worker: workers)
+            worker.join();
+    }
+
+    //first index of part t when [0, total) is split into threads parts
+    inline long long Chunk_Begin(long long total, int threads, int t)
+    {
+        return total * t / threads;
+    }
+}
+
+#endif //BANDBMCP_PARALLEL_HPP
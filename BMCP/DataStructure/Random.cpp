@@ -0,0 +1,34 @@
+#include "Random.hpp"
+
+BMCP::Random::Random(const unsigned int seed)
+{
+    this->seed(seed);
+}
+
+void BMCP::Random::seed(unsigned int seed)
+{
+    if (seed == 0) seed = 1;
+    _state[0] = seed;
+    int32_t word = (int32_t) seed;
+    for (int i = 1; i < degree; i++)
+    {
+        //word = 16807 * word % 2147483647 without overflowing 31 bits
+        int32_t hi = word / 127773;
+        int32_t lo = word % 127773;
+        word = 16807 * lo - 2836 * hi;
+        if (word < 0) word += 2147483647;
+        _state[i] = word;
+    }
+    _front = separation;
+    _rear = 0;
+    for (int i = 0; i < 10 * degree; i++)
+        next();
+}
+
+int BMCP::Random::next()
+{
+    uint32_t value = _state[_front] += _state[_rear];
+    if (++_front == degree) _front = 0;
+    if (++_rear == degree) _rear = 0;
+    return (int) (value >> 1);
+}
@@ -0,0 +1,29 @@
+#ifndef BANDBMCP_RANDOM_HPP
+#define BANDBMCP_RANDOM_HPP
+
+#include <cstdint>
+
+namespace BMCP
+{
+    //the additive feedback generator behind glibc srand/rand, so a seed gives the same
+    //sequence as before, but every owner has its own state and can run on its own thread
+    class Random
+    {
+    private:
+        static constexpr int degree = 31;
+        static constexpr int separation = 3;
+        uint32_t _state[degree];
+        int _front;
+        int _rear;
+
+    public:
+        explicit Random(unsigned int seed = 1);
+
+        void seed(unsigned int);
+
+        //uniform in [0, 2^31 - 1], like rand()
+        int next();
+    };
+}
+
+#endif //BANDBMCP_RANDOM_HPP
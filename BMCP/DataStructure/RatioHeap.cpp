@@ -0,0 +1,49 @@
+#include "RatioHeap.hpp"
+#include <algorithm>
+
+bool BMCP::RatioHeap::better(const Entry &a, const Entry &b)
+{
+    //128-bit products, the contributions may take the whole 64 bits
+    __int128 lhs = (__int128) a.contribution * b.weight;
+    __int128 rhs = (__int128) b.contribution * a.weight;
+    if (lhs != rhs) return lhs > rhs;
+    return a.id < b.id;
+}
+
+void BMCP::RatioHeap::push(const long long contribution, const int weight, const int id)
+{
+    _heap.push_back({contribution, weight, id});
+    std::push_heap(_heap.begin(), _heap.end(), [](const Entry &a, const Entry &b)
+    {
+        return better(b, a);
+    });
+}
+
+const BMCP::RatioHeap::Entry &BMCP::RatioHeap::top() const
+{
+    return _heap.front();
+}
+
+void BMCP::RatioHeap::pop()
+{
+    std::pop_heap(_heap.begin(), _heap.end(), [](const Entry &a, const Entry &b)
+    {
+        return better(b, a);
+    });
+    _heap.pop_back();
+}
+
+bool BMCP::RatioHeap::empty() const
+{
+    return _heap.empty();
+}
+
+int BMCP::RatioHeap::size() const
+{
+    return (int) _heap.size();
+}
+
+void BMCP::RatioHeap::clear()
+{
+    _heap.clear();
+}
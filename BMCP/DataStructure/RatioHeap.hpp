@@ -0,0 +1,41 @@
+#ifndef BANDBMCP_RATIOHEAP_HPP
+#define BANDBMCP_RATIOHEAP_HPP
+
+#include <vector>
+
+namespace BMCP
+{
+    //binary max-heap of (contribution, weight, id) ordered by contribution / weight,
+    //equal densities by lower id. Entries are never updated in place: callers push
+    //the new key and drop stale entries when they reach the top.
+    class RatioHeap
+    {
+    public:
+        struct Entry
+        {
+            long long contribution;
+            int weight;
+            int id;
+        };
+
+    private:
+        std::vector<Entry> _heap;
+
+        static bool better(const Entry &, const Entry &);
+
+    public:
+        void push(long long contribution, int weight, int id);
+
+        const Entry &top() const;
+
+        void pop();
+
+        bool empty() const;
+
+        int size() const;
+
+        void clear();
+    };
+}
+
+#endif //BANDBMCP_RATIOHEAP_HPP
@@ -0,0 +1,72 @@
+#include "WorkerPool.hpp"
+
+BMCP::WorkerPool::WorkerPool(const int threads) : _invoke(nullptr), _task(nullptr), _generation(0), _pending(0),
+                                                  _stop(false)
+{
+    for (int t = 1; t < threads; t++)
+        _workers.emplace_back(&WorkerPool::work, this, t);
+}
+
+int BMCP::WorkerPool::threads() const
+{
+    return (int) _workers.size() + 1;
+}
+
+void BMCP::WorkerPool::work(const int t)
+{
+    long long seen = 0;
+    while (true)
+    {
+        void (*invoke)(void *, int);
+        void *task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _start.wait(lock, [this, seen]()
+            {
+                return _stop || _generation != seen;
+            });
+            if (_stop) return;
+            seen = _generation;
+            invoke = _invoke;
+            task = _task;
+        }
+        invoke(task, t);
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_pending == 0)
+            _done.notify_one();
+    }
+}
+
+void BMCP::WorkerPool::dispatch(void (*invoke)(void *, int), void *task)
+{
+    if (_workers.empty())
+    {
+        invoke(task, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _invoke = invoke;
+        _task = task;
+        _pending = (int) _workers.size();
+        _generation++;
+    }
+    _start.notify_all();
+    invoke(task, 0);
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]()
+    {
+        return _pending == 0;
+    });
+}
+
+BMCP::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _start.notify_all();
+    for (std::thread &worker: _workers)
+        worker.join();
+}
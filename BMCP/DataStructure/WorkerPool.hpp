@@ -0,0 +1,57 @@
+#ifndef BANDBMCP_WORKERPOOL_HPP
+#define BANDBMCP_WORKERPOOL_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BMCP
+{
+    //threads - 1 persistent workers for short parallel loops that run too often to start
+    //threads each time. run(task) calls task(t) for t in [0, threads), t = 0 on the calling
+    //thread, so a loop split with Chunk_Begin gives part t to the same worker on every call
+    //and the part stays in that worker's cache
+    class WorkerPool
+    {
+    private:
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        void (*_invoke)(void *, int);
+        void *_task;
+        long long _generation;
+        int _pending;
+        bool _stop;
+
+        void work(int t);
+
+        void dispatch(void (*)(void *, int), void *);
+
+    public:
+        explicit WorkerPool(int threads);
+
+        WorkerPool(const WorkerPool &) = delete;
+
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        int threads() const;
+
+        template<typename Task>
+        void run(Task &task);
+
+        ~WorkerPool();
+    };
+
+    template<typename Task>
+    void WorkerPool::run(Task &task)
+    {
+        dispatch([](void *context, const int t)
+                 {
+                     (*static_cast<Task *>(context))(t);
+                 }, &task);
+    }
+}
+
+#endif //BANDBMCP_WORKERPOOL_HPP
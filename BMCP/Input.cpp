@@ -1,56 +1,78 @@
 #include <BMCP.hpp>
+#include <climits>
 
-BMCP::BMCPSolver::BMCPSolver(Graph *g, unsigned int seed, int time_limit, int Imax1,
-                             int Imax2, double lambda) :
-        g(g), seed(seed), time_limit(time_limit), Imax1(Imax1), Imax2(Imax2), lambda(lambda)
+template<typename Numeric>
+BMCP::BMCPSolver<Numeric>::BMCPSolver(Graph *g, unsigned int seed, int time_limit, int Imax1,
+                                      int Imax2, double lambda) :
+        g(g), removal_heap(g->m), candidates(g->m), arms(g->m), seed(seed), time_limit(time_limit), Imax1(Imax1), Imax2(Imax2), lambda(lambda)
 {
     //rand engine
     //linear_rand = new std::minstd_rand(seed);
-    srand(this->seed);
+    random.seed(this->seed);
 
     //distribute memory
     solution = new int[g->m + 1];
-    solution_contribution = new int[g->m + 1];
-    solution_elements = new int[g->n + 1];
+    solution_contribution = new value[g->m + 1];
+    solution_elements = new count[g->n + 1];
+    solution_owner = new int[g->n + 1];
 
     best_solution = new int[g->m + 1];
-    best_solution_contribution = new int[g->m + 1];
-    best_solution_elements = new int[g->n + 1];
+    best_solution_contribution = new value[g->m + 1];
+    best_solution_elements = new count[g->n + 1];
+    best_solution_owner = new int[g->n + 1];
 
-    star_solution = new int[g->m + 1];
-    star_solution_contribution = new int[g->m + 1];
-    star_solution_elements = new int[g->n + 1];
-
-    conf_change_out_of_solution = new int[g->m + 1];
-    origin_conf_change_out_of_solution = new int[g->m + 1];
-    conf_change_in_solution = new int[g->m + 1];
-    origin_conf_change_in_solution = new int[g->m + 1];
+    conf_change_out_of_solution = new value[g->m + 1];
+    origin_conf_change_out_of_solution = new value[g->m + 1];
+    conf_change_in_solution = new value[g->m + 1];
+    origin_conf_change_in_solution = new value[g->m + 1];
     conf_change_timestamp = new int[g->m + 1];
 
     block_list = new int[g->m + 1];
     r_sum = new double[g->m + 1];
     select_times = new int[g->m + 1];
+    arms_dirty_mark = new int[g->m + 1];
+    for (int i = 0; i <= g->m; i++)
+        arms_dirty_mark[i] = 0;
+
+    removal_indexed = false;
+
+    //best_solution snapshots
+    journaling = false;
+    best_in_arrays = true;
+    journal_cost = 0;
+    snapshot_copies = 0;
+    snapshot_rollbacks = 0;
+
+    part_best.assign(1, -1);
+
+    //solution loading
+    load_mark = new int[g->m + 1];
+    for (int i = 0; i <= g->m; i++)
+        load_mark[i] = 0;
 
+    //swap neighbourhood
+    swap_shared = new value[g->m + 1];
+    for (int i = 0; i <= g->m; i++)
+        swap_shared[i] = 0;
+
+    //change tracking
+    changed_mark = new int[g->m + 1];
+    for (int i = 0; i <= g->m; i++)
+        changed_mark[i] = 0;
+
+
+    //stop control
+    anytime = false;
+    stopping = false;
+    start_time = std::chrono::steady_clock::now();
 
     //init star_solution
     total_iterations = 0;
     star_solution_iterations = 0;
+    star_solution_time = 0;
     star_solution_profit_sum = 0;
     star_solution_weight_sum = 0;
     star_solution_size = 0;
-    for (int i = 1; i <= g->m; i++)
-    {
-        star_solution_contribution[i] = 0;
-        for (int nei: g->item_neighbor[i])
-        {
-            star_solution_contribution[i] += g->profit[nei];
-        }
-        star_solution[i] = 0;
-    }
-    for (int i = 1; i <= g->n; i++)
-    {
-        star_solution_elements[i] = 0;
-    }
 
     //init solution
     solution_weight_sum = 0;
@@ -68,7 +90,9 @@ BMCP::BMCPSolver::BMCPSolver(Graph *g, unsigned int seed, int time_limit, int Im
     for (int i = 1; i <= g->n; i++)
     {
         solution_elements[i] = 0;
+        solution_owner[i] = 0;
     }
+    Build_Candidates();
 
     //init deep-opt
     ll avg_weight = 0;
@@ -78,6 +102,12 @@ BMCP::BMCPSolver::BMCPSolver(Graph *g, unsigned int seed, int time_limit, int Im
         block_list[i] = 0;
         avg_weight += g->weight[i];
     }
-    block_list_size = std::max(1, (int) ceil(g->C * g->m / avg_weight * 0.1));
+    double block_size = ceil((ll) g->C * g->m / std::max(1LL, avg_weight) * 0.1);
+    block_list_size = (int) std::clamp(block_size, 1.0, (double) INT_MAX);
     tabu_list = new int[g->m + 1];
-}
\ No newline at end of file
+}
+
+template BMCP::BMCPSolver<BMCP::Value32Count16>::BMCPSolver(Graph *, unsigned int, int, int, int, double);
+template BMCP::BMCPSolver<BMCP::Value32Count32>::BMCPSolver(Graph *, unsigned int, int, int, int, double);
+template BMCP::BMCPSolver<BMCP::Value64Count16>::BMCPSolver(Graph *, unsigned int, int, int, int, double);
+template BMCP::BMCPSolver<BMCP::Value64Count32>::BMCPSolver(Graph *, unsigned int, int, int, int, double);
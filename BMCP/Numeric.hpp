@@ -0,0 +1,45 @@
+#ifndef BANDBMCP_NUMERIC_HPP
+#define BANDBMCP_NUMERIC_HPP
+
+#include <Graph.hpp>
+#include <climits>
+#include <cstdint>
+
+namespace BMCP
+{
+    //numeric types of a solver instantiation
+    //value: contributions and the profit and weight sums
+    //count: the number of items in solution covering an element
+    //wide: products value * weight, used to compare densities
+    template<typename Value, typename Count, typename Wide>
+    struct Numeric
+    {
+        using value = Value;
+        using count = Count;
+        using wide = Wide;
+    };
+
+    using Value32Count16 = Numeric<int, uint16_t, long long>;
+    using Value32Count32 = Numeric<int, int, long long>;
+    using Value64Count16 = Numeric<long long, uint16_t, __int128>;
+    using Value64Count32 = Numeric<long long, int, __int128>;
+
+    //call f with the narrowest instantiation that cannot overflow on g: 32-bit values while
+    //neither the profits nor the weights sum above INT_MAX, 16-bit counts while no element
+    //has more than UINT16_MAX items
+    template<typename F>
+    decltype(auto) With_Numeric(const Graph *g, F &&f)
+    {
+        bool value32 = g->Total_Profit() <= INT_MAX && g->Total_Weight() <= INT_MAX;
+        bool count16 = g->Max_Element_Degree() <= UINT16_MAX;
+        if (value32)
+        {
+            if (count16) return f(Value32Count16());
+            return f(Value32Count32());
+        }
+        if (count16) return f(Value64Count16());
+        return f(Value64Count32());
+    }
+}
+
+#endif //BANDBMCP_NUMERIC_HPP
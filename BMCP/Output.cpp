@@ -1,25 +1,77 @@
 #include <BMCP.hpp>
+#include <algorithm>
 #include <cstdio>
+#include <vector>
 
-void BMCP::BMCPSolver::Output() const
+template<typename Numeric>
+void BMCP::BMCPSolver<Numeric>::Output() const
 {
-    //printf("%d %d %lf %d %d", seed, star_solution_profit_sum, 1.0 * star_solution_time / CLOCKS_PER_SEC,
+    //printf("%d %d %lf %d %d", seed, star_solution_profit_sum, star_solution_time,
     //       star_solution_iterations, total_iterations);
 }
 
-BMCP::BMCPSolver::~BMCPSolver()
+template<typename Numeric>
+bool BMCP::BMCPSolver<Numeric>::Output_Solution(const char *file_path) const
+{
+    FILE *file = fopen(file_path, "w");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        return false;
+    }
+    std::vector<int> items;
+    for (int item: in_star_solution)
+        items.push_back(g->Item_Origin(item));
+    std::sort(items.begin(), items.end());
+    for (int item: items)
+        fprintf(file, "%d\n", item);
+    return fclose(file) == 0;
+}
+
+template<typename Numeric>
+bool BMCP::BMCPSolver<Numeric>::Output_Stats(const char *file_path) const
+{
+#ifdef BANDBMCP_STATS
+    FILE *file = fopen(file_path, "w");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        return false;
+    }
+    fprintf(file, "{\n  \"m\": %d,\n  \"n\": %d,\n  \"seed\": %u,\n", g->m, g->n, seed);
+    fprintf(file, "  \"iterations\": %d,\n  \"profit\": %lld,\n  \"phases\": {\n", total_iterations,
+            (long long) star_solution_profit_sum);
+    for (int p = 0; p < phase_count; p++)
+    {
+        const PhaseStats &phase = stats.phases[p];
+        fprintf(file, "    \"%s\": {\"seconds\": %.6f, \"calls\": %lld, \"moves\": %lld, "
+                      "\"moves_per_second\": %.1f, \"elements_per_move\": %.2f, \"scans\": %lld, "
+                      "\"improvements\": %lld}%s\n",
+                Phase_Name((Phase) p), phase.seconds, phase.calls, phase.moves,
+                phase.seconds > 0 ? phase.moves / phase.seconds : 0.0,
+                phase.moves > 0 ? 1.0 * phase.elements / phase.moves : 0.0, phase.scans, phase.improvements,
+                p + 1 < phase_count ? "," : "");
+    }
+    fputs("  }\n}\n", file);
+    return fclose(file) == 0;
+#else
+    fprintf(stderr, "no stats for %s, build with -DBANDBMCP_STATS=ON\n", file_path);
+    return false;
+#endif
+}
+
+template<typename Numeric>
+BMCP::BMCPSolver<Numeric>::~BMCPSolver()
 {
     delete[] solution;
     delete[] solution_contribution;
     delete[] solution_elements;
+    delete[] solution_owner;
 
     delete[] best_solution;
     delete[] best_solution_contribution;
     delete[] best_solution_elements;
-
-    delete[] star_solution;
-    delete[] star_solution_contribution;
-    delete[] star_solution_elements;
+    delete[] best_solution_owner;
 
     delete[] conf_change_out_of_solution;
     delete[] origin_conf_change_out_of_solution;
@@ -29,8 +81,32 @@ BMCP::BMCPSolver::~BMCPSolver()
 
     delete[] r_sum;
     delete[] select_times;
+    delete[] arms_dirty_mark;
 
     delete[] block_list;
     delete[] tabu_list;
+
+    delete[] changed_mark;
+    delete[] load_mark;
+    delete[] swap_shared;
 }
 
+template void BMCP::BMCPSolver<BMCP::Value32Count16>::Output() const;
+template bool BMCP::BMCPSolver<BMCP::Value32Count16>::Output_Solution(const char *) const;
+template bool BMCP::BMCPSolver<BMCP::Value32Count16>::Output_Stats(const char *) const;
+template BMCP::BMCPSolver<BMCP::Value32Count16>::~BMCPSolver();
+
+template void BMCP::BMCPSolver<BMCP::Value32Count32>::Output() const;
+template bool BMCP::BMCPSolver<BMCP::Value32Count32>::Output_Solution(const char *) const;
+template bool BMCP::BMCPSolver<BMCP::Value32Count32>::Output_Stats(const char *) const;
+template BMCP::BMCPSolver<BMCP::Value32Count32>::~BMCPSolver();
+
+template void BMCP::BMCPSolver<BMCP::Value64Count16>::Output() const;
+template bool BMCP::BMCPSolver<BMCP::Value64Count16>::Output_Solution(const char *) const;
+template bool BMCP::BMCPSolver<BMCP::Value64Count16>::Output_Stats(const char *) const;
+template BMCP::BMCPSolver<BMCP::Value64Count16>::~BMCPSolver();
+
+template void BMCP::BMCPSolver<BMCP::Value64Count32>::Output() const;
+template bool BMCP::BMCPSolver<BMCP::Value64Count32>::Output_Solution(const char *) const;
+template bool BMCP::BMCPSolver<BMCP::Value64Count32>::Output_Stats(const char *) const;
+template BMCP::BMCPSolver<BMCP::Value64Count32>::~BMCPSolver();
@@ -0,0 +1,143 @@
+#include <Portfolio.hpp>
+#include <BMCP.hpp>
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+BMCP::SharedStar::SharedStar() : best(nullptr) {}
+
+bool BMCP::SharedStar::Publish(const long long profit, const int *begin, const int *end)
+{
+    const Snapshot *current = best.load(std::memory_order_acquire);
+    if (current != nullptr && current->profit >= profit) return false;
+    Snapshot *snapshot = new Snapshot{profit, std::vector<int>(begin, end), current};
+    while (!best.compare_exchange_weak(current, snapshot, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        if (current != nullptr && current->profit >= profit)
+        {
+            delete snapshot;
+            return false;
+        }
+        snapshot->older = current;
+    }
+    return true;
+}
+
+const BMCP::SharedStar::Snapshot *BMCP::SharedStar::Load() const
+{
+    return best.load(std::memory_order_acquire);
+}
+
+BMCP::SharedStar::~SharedStar()
+{
+    const Snapshot *snapshot = best.load(std::memory_order_relaxed);
+    while (snapshot != nullptr)
+    {
+        const Snapshot *older = snapshot->older;
+        delete snapshot;
+        snapshot = older;
+    }
+}
+
+//Imax1 and Imax2 factors and a lambda offset, cycled through by solver index
+static const struct
+{
+    double imax1;
+    double imax2;
+    double lambda;
+} variations[] = {{1, 1, 0}, {2, 1, 0}, {1, 2, 0}, {1, 1, -0.1}, {1, 1, 0.1}, {0.5, 0.5, 0}, {2, 2, -0.1},
+                  {0.5, 2, 0.1}};
+
+template<typename Numeric>
+BMCP::PortfolioResult BMCP::Solve_Portfolio(Graph *g, const int threads, const unsigned int seed, const int time_limit,
+                                            const int Imax1, const int Imax2, const double lambda,
+                                            const int migration_period, const bool random_topology,
+                                            const char *solution_path, const StopCriteria &stop,
+                                            const int swap_samples, const std::vector<int> &initial_solution)
+{
+    bool islands = migration_period > 0 && threads > 1;
+    SharedStar star;
+    std::vector<std::unique_ptr<SharedStar>> inboxes;
+    if (islands)
+    {
+        for (int k = 0; k < threads; k++)
+            inboxes.emplace_back(new SharedStar());
+    }
+    std::vector<std::unique_ptr<BMCPSolver<Numeric>>> solvers;
+    for (int k = 0; k < threads; k++)
+    {
+        const auto &variation = variations[k % (sizeof(variations) / sizeof(variations[0]))];
+        solvers.emplace_back(new BMCPSolver<Numeric>(g, seed + k, time_limit,
+                                                     std::max(1, (int) (Imax1 * variation.imax1)),
+                                                     std::max(1, (int) (Imax2 * variation.imax2)),
+                                                     std::clamp(lambda + variation.lambda, 0.05, 1.0)));
+        solvers.back()->Set_Stop_Criteria(stop);
+        solvers.back()->Use_Swaps(swap_samples);
+        solvers.back()->Set_Initial_Solution(initial_solution);
+        solvers.back()->Share(&star, !islands);
+        if (!islands) continue;
+        std::vector<SharedStar *> neighbours;
+        if (random_topology)
+        {
+            for (int j = 0; j < threads; j++)
+            {
+                if (j != k) neighbours.push_back(inboxes[j].get());
+            }
+        }
+        else
+            neighbours.push_back(inboxes[(k + 1) % threads].get());
+        solvers.back()->Join_Islands(inboxes[k].get(), neighbours, migration_period);
+    }
+    std::vector<std::thread> workers;
+    for (auto &solver: solvers)
+        workers.emplace_back([&solver]()
+        {
+            solver->Solve();
+        });
+    for (std::thread &worker: workers)
+        worker.join();
+
+    PortfolioResult result{0, 0, {}, 0};
+    BMCPSolver<Numeric> *best = solvers.front().get();
+    std::vector<Improvement> events;
+    for (auto &solver: solvers)
+    {
+        result.iterations += solver->total_iterations;
+        if (solver->star_solution_profit_sum > best->star_solution_profit_sum)
+            best = solver.get();
+        std::vector<Improvement> own = solver->Trace().events();
+        result.trace_dropped += solver->Trace().total() - (long long) own.size();
+        events.insert(events.end(), own.begin(), own.end());
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Improvement &a, const Improvement &b)
+    {
+        return a.time < b.time;
+    });
+    for (const Improvement &event: events)
+    {
+        if (result.trace.empty() || event.profit > result.trace.back().profit)
+            result.trace.push_back(event);
+    }
+    result.profit = best->star_solution_profit_sum;
+    best->Output();
+    if (solution_path != nullptr)
+        best->Output_Solution(solution_path);
+    return result;
+}
+
+template BMCP::PortfolioResult BMCP::Solve_Portfolio<BMCP::Value32Count16>(Graph *, int, unsigned int, int, int, int, double,
+                                                                          int, bool, const char *,
+                                                                          const StopCriteria &, int,
+                                                                          const std::vector<int> &);
+template BMCP::PortfolioResult BMCP::Solve_Portfolio<BMCP::Value32Count32>(Graph *, int, unsigned int, int, int, int, double,
+                                                                          int, bool, const char *,
+                                                                          const StopCriteria &, int,
+                                                                          const std::vector<int> &);
+template BMCP::PortfolioResult BMCP::Solve_Portfolio<BMCP::Value64Count16>(Graph *, int, unsigned int, int, int, int, double,
+                                                                          int, bool, const char *,
+                                                                          const StopCriteria &, int,
+                                                                          const std::vector<int> &);
+template BMCP::PortfolioResult BMCP::Solve_Portfolio<BMCP::Value64Count32>(Graph *, int, unsigned int, int, int, int, double,
+                                                                          int, bool, const char *,
+                                                                          const StopCriteria &, int,
+                                                                          const std::vector<int> &);
@@ -0,0 +1,70 @@
+#ifndef BANDBMCP_PORTFOLIO_HPP
+#define BANDBMCP_PORTFOLIO_HPP
+
+#include <Graph.hpp>
+#include <Control.hpp>
+#include <Trace.hpp>
+#include <atomic>
+#include <vector>
+
+namespace BMCP
+{
+    //the best solution of all solvers of a portfolio. A publish swaps in a new immutable
+    //snapshot with a compare-and-swap, so neither side takes a lock; replaced snapshots are
+    //kept until the SharedStar is destroyed, so a reader never sees freed memory
+    class SharedStar
+    {
+    public:
+        struct Snapshot
+        {
+            long long profit;
+            std::vector<int> items;
+            const Snapshot *older;
+        };
+
+    private:
+        std::atomic<const Snapshot *> best;
+
+    public:
+        SharedStar();
+
+        SharedStar(const SharedStar &) = delete;
+
+        SharedStar &operator=(const SharedStar &) = delete;
+
+        //false if the shared star already has at least this profit
+        bool Publish(long long profit, const int *begin, const int *end);
+
+        //nullptr before the first publish
+        const Snapshot *Load() const;
+
+        ~SharedStar();
+    };
+
+    struct PortfolioResult
+    {
+        long long profit;
+        //outer iterations of all solvers together
+        long long iterations;
+        //the improvements of all solvers that raised the best of the portfolio, by time
+        std::vector<Improvement> trace;
+        //improvements the solvers overwrote in their ImprovementTrace before the merge
+        long long trace_dropped;
+    };
+
+    //run threads solvers on g until the time limit and write the best star to solution_path
+    //(if not nullptr). Solver k uses seed + k and the k-th parameter variation; solver 0 runs
+    //with the parameters as given. With migration_period 0 the solvers are independent and
+    //adopt the shared star when they stagnate; otherwise they are islands sending their star
+    //every migration_period iterations to the next island (ring) or a random one. The stop
+    //criteria apply to every solver; the target is checked against the shared star. Every
+    //solver tries swap_samples 1-1 swaps per stuck Deep_Optimize step and, if initial_solution
+    //is not empty, starts from it
+    template<typename Numeric>
+    PortfolioResult Solve_Portfolio(Graph *g, int threads, unsigned int seed, int time_limit, int Imax1, int Imax2,
+                                    double lambda, int migration_period, bool random_topology,
+                                    const char *solution_path, const StopCriteria &stop = StopCriteria(),
+                                    int swap_samples = 0, const std::vector<int> &initial_solution = {});
+}
+
+#endif //BANDBMCP_PORTFOLIO_HPP
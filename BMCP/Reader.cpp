@@ -0,0 +1,438 @@
+#include <Reader.hpp>
+#include <BinaryGraph.hpp>
+#include <MappedFile.hpp>
+#include <Parallel.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    //bounded cursor over a mapped text file
+    struct Cursor
+    {
+        const char *p;
+        const char *end;
+
+        static bool Is_Space(char c)
+        {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+        }
+
+        void Skip_Space()
+        {
+            while (p < end && Is_Space(*p)) p++;
+        }
+
+        void Skip_Line()
+        {
+            while (p < end && *p != '\n') p++;
+            if (p < end) p++;
+        }
+
+        //move behind the next occurrence of key
+        bool Find(const char *key)
+        {
+            size_t len = strlen(key);
+            while (p + len <= end)
+            {
+                const void *hit = memchr(p, key[0], end - p);
+                if (hit == nullptr) break;
+                p = (const char *) hit;
+                if (p + len <= end && memcmp(p, key, len) == 0)
+                {
+                    p += len;
+                    return true;
+                }
+                p++;
+            }
+            p = end;
+            return false;
+        }
+
+        bool Parse_Int(int &value)
+        {
+            Skip_Space();
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                p++;
+            }
+            if (p == end || *p < '0' || *p > '9') return false;
+            long long v = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+            {
+                v = v * 10 + (*p - '0');
+                p++;
+            }
+            value = (int) (negative ? -v : v);
+            return true;
+        }
+    };
+
+    [[noreturn]] void Fail(const char *file_path, const char *what)
+    {
+        fprintf(stderr, "fail to parse %s: %s\n", file_path, what);
+        exit(1);
+    }
+
+    void Finalize(BMCP::Graph *g, const char *file_path, int threads = 1)
+    {
+        long long merged;
+        try
+        {
+            merged = g->Finalize(threads);
+        }
+        catch (const std::out_of_range &e)
+        {
+            Fail(file_path, e.what());
+        }
+        if (merged > 0)
+            fprintf(stderr, "merged %lld duplicate edges in %s\n", merged, file_path);
+    }
+
+    //generic tokenizer for one cell of the relation matrix at token index cell
+    void Scan_Relation_Cell(BMCP::Graph *g, Cursor &cur, long long cell, const char *file_path)
+    {
+        int relation;
+        if (!cur.Parse_Int(relation))
+            Fail(file_path, "relation matrix is incomplete");
+        if (relation)
+        {
+            int i = (int) (cell / g->n) + 1;
+            int j = (int) (cell % g->n) + 1;
+            g->Add_Edge(i, j);
+        }
+    }
+
+    //generic tokenizer for the relation matrix, resumes at token index cell
+    void Scan_Relation_Scalar(BMCP::Graph *g, Cursor &cur, long long cell, const char *file_path)
+    {
+        const long long cells = (long long) g->m * g->n;
+        for (; cell < cells; cell++)
+            Scan_Relation_Cell(g, cur, cell, file_path);
+    }
+
+    //every cell of the relation matrix is a single 0/1 character separated by blanks,
+    //so the index of a cell is the number of digits in front of it. Whole blocks of 16
+    //bytes are classified at once, and only the positions of '1' are visited. A block
+    //holding anything else hands a single token to the tokenizer.
+    void Scan_Relation(BMCP::Graph *g, Cursor &cur, const char *file_path)
+    {
+        const long long cells = (long long) g->m * g->n;
+        long long cell = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i one = _mm_set1_epi8('1');
+        const __m128i blank = _mm_set1_epi8(' ');
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i carriage = _mm_set1_epi8('\r');
+        const __m128i tab = _mm_set1_epi8('\t');
+        while (cur.end - cur.p > 16 && cell < cells)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i *) cur.p);
+            __m128i is_one = _mm_cmpeq_epi8(block, one);
+            __m128i is_digit = _mm_or_si128(_mm_cmpeq_epi8(block, zero), is_one);
+            __m128i is_space = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, blank),
+                                                         _mm_cmpeq_epi8(block, newline)),
+                                            _mm_or_si128(_mm_cmpeq_epi8(block, carriage),
+                                                         _mm_cmpeq_epi8(block, tab)));
+            unsigned digits = _mm_movemask_epi8(is_digit);
+            unsigned ones = _mm_movemask_epi8(is_one);
+            unsigned spaces = _mm_movemask_epi8(is_space);
+            //the byte behind the block is part of the last token if both are digits
+            unsigned next = cur.p[16] >= '0' && cur.p[16] <= '9';
+            if ((digits | spaces) != 0xFFFF || (digits & ((digits >> 1) | (next << 15))))
+            {
+                //only the next token goes through the tokenizer, the scan resumes behind it
+                Scan_Relation_Cell(g, cur, cell++, file_path);
+                continue;
+            }
+            int count = __builtin_popcount(digits);
+            if (cell + count > cells)
+                break;
+            while (ones)
+            {
+                int bit = __builtin_ctz(ones);
+                long long index = cell + __builtin_popcount(digits & ((1u << bit) - 1));
+                int i = (int) (index / g->n) + 1;
+                int j = (int) (index % g->n) + 1;
+                g->Add_Edge(i, j);
+                ones &= ones - 1;
+            }
+            cell += count;
+            cur.p += 16;
+        }
+#endif
+        //the cells of the last block
+        Scan_Relation_Scalar(g, cur, cell, file_path);
+    }
+}
+
+BMCP::Graph *BMCP::Input_From_File1(const char *file_path)
+{
+    FILE *file = fopen(file_path, "rb");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        exit(1);
+    }
+    int m, n, C;
+    fscanf(file, "\n");
+    fscanf(file, "m=%d n=%d knapsack size=%d\n", &m, &n, &C);
+    Graph *g = new Graph(m, n, C);
+    fscanf(file, "\n");
+    fscanf(file, "The weight of %*d items_next");
+    for (int i = 1; i <= g->m; i++)
+    {
+        fscanf(file, "%d", g->weight + i);
+    }
+    fscanf(file, "\n");
+    fscanf(file, "The profit of %*d elements_next");
+    for (int i = 1; i <= g->n; i++)
+    {
+        fscanf(file, "%d", g->profit + i);
+    }
+    fscanf(file, "\n");
+    fscanf(file, "Relation matix");
+    int relation;
+    for (int i = 1; i <= g->m; i++)
+    {
+        for (int j = 1; j <= g->n; j++)
+        {
+            fscanf(file, "%d", &relation);
+            if (relation)
+            {
+                g->Add_Edge(i, j);
+            }
+        }
+    }
+    fclose(file);
+    Finalize(g, file_path);
+    return g;
+}
+
+BMCP::Graph *BMCP::Fast_Input_From_File1(const char *file_path)
+{
+    MappedFile file;
+    if (!file.open(file_path))
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        exit(1);
+    }
+    Cursor cur{file.data(), file.data() + file.size()};
+    int m, n, C;
+    if (!cur.Find("m=") || !cur.Parse_Int(m) ||
+        !cur.Find("n=") || !cur.Parse_Int(n) ||
+        !cur.Find("size=") || !cur.Parse_Int(C))
+        Fail(file_path, "bad header");
+    if (m < 0 || n < 0)
+        Fail(file_path, "bad header");
+    Graph *g = new Graph(m, n, C);
+    //the label lines carry counts themselves, so skip them as a whole
+    if (!cur.Find("weight")) Fail(file_path, "missing weights");
+    cur.Skip_Line();
+    for (int i = 1; i <= g->m; i++)
+    {
+        if (!cur.Parse_Int(g->weight[i])) Fail(file_path, "missing weights");
+    }
+    if (!cur.Find("profit")) Fail(file_path, "missing profits");
+    cur.Skip_Line();
+    for (int i = 1; i <= g->n; i++)
+    {
+        if (!cur.Parse_Int(g->profit[i])) Fail(file_path, "missing profits");
+    }
+    if (!cur.Find("Relation")) Fail(file_path, "missing relation matrix");
+    cur.Skip_Line();
+    Scan_Relation(g, cur, file_path);
+    Finalize(g, file_path);
+    return g;
+}
+
+BMCP::Graph *BMCP::Input_From_File2(const char *file_path)
+{
+    FILE *file = fopen(file_path, "rb");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        exit(1);
+    }
+    int m, n, C;
+    int line;
+    fscanf(file, "%d %d %d %d", &m, &n, &line, &C);
+    Graph *g = new Graph(m, n, C);
+    for (int i = 1; i <= line; i++)
+    {
+        int u, v;
+        fscanf(file, "%d %d", &u, &v);
+        g->Add_Edge(u, v);
+    }
+    for (int i = 1; i <= m; i++)
+    {
+        fscanf(file, "%d", g->weight + i);
+    }
+    for (int i = 1; i <= n; i++)
+    {
+        fscanf(file, "%d", g->profit + i);
+    }
+    fclose(file);
+    Finalize(g, file_path);
+    return g;
+}
+
+BMCP::Graph *BMCP::Fast_Input_From_File2(const char *file_path, int threads)
+{
+    MappedFile file;
+    if (!file.open(file_path))
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        exit(1);
+    }
+    Cursor cur{file.data(), file.data() + file.size()};
+    int m, n, line, C;
+    if (!cur.Parse_Int(m) || !cur.Parse_Int(n) || !cur.Parse_Int(line) || !cur.Parse_Int(C) ||
+        m < 0 || n < 0 || line < 0)
+        Fail(file_path, "bad header");
+    Graph *g = new Graph(m, n, C);
+
+    //the last m + n tokens are the weights and profits, everything in front of them is the edge list
+    const char *edge_begin = cur.p;
+    const char *edge_end = cur.end;
+    for (int need = m + n; need > 0; need--)
+    {
+        while (edge_end > edge_begin && Cursor::Is_Space(edge_end[-1])) edge_end--;
+        if (edge_end == edge_begin) Fail(file_path, "missing weights or profits");
+        while (edge_end > edge_begin && !Cursor::Is_Space(edge_end[-1])) edge_end--;
+    }
+    Cursor tail{edge_end, cur.end};
+    for (int i = 1; i <= m; i++)
+    {
+        if (!tail.Parse_Int(g->weight[i])) Fail(file_path, "missing weights");
+    }
+    for (int i = 1; i <= n; i++)
+    {
+        if (!tail.Parse_Int(g->profit[i])) Fail(file_path, "missing profits");
+    }
+
+    if (threads <= 0) threads = (int) std::max(1u, std::thread::hardware_concurrency());
+    long long length = edge_end - edge_begin;
+    threads = (int) std::max(1LL, std::min<long long>(threads, length >> 20));
+    //split the edge list into byte ranges that end on a blank
+    std::vector<const char *> bound(threads + 1);
+    bound[0] = edge_begin;
+    for (int t = 1; t < threads; t++)
+    {
+        const char *p = std::max(bound[t - 1], edge_begin + Chunk_Begin(length, threads, t));
+        while (p < edge_end && !Cursor::Is_Space(*p)) p++;
+        bound[t] = p;
+    }
+    bound[threads] = edge_end;
+
+    std::vector<std::vector<int>> tokens(threads);
+    std::vector<char> bad(threads, 0);
+    Run_Parallel(threads, [&](int t)
+    {
+        std::vector<int> &local = tokens[t];
+        local.reserve((bound[t + 1] - bound[t]) / 4);
+        const char *p = bound[t];
+        const char *end = bound[t + 1];
+        while (true)
+        {
+            while (p < end && Cursor::Is_Space(*p)) p++;
+            if (p == end) break;
+            if (*p < '0' || *p > '9')
+            {
+                bad[t] = 1;
+                break;
+            }
+            long long v = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+            {
+                v = v * 10 + (*p - '0');
+                if (v > 0x7fffffff) v = 0x7fffffff;
+                p++;
+            }
+            local.push_back((int) v);
+        }
+    });
+    //first token of every range, the parity says whether a range starts with an item or an element
+    std::vector<long long> first(threads + 1, 0);
+    for (int t = 0; t < threads; t++)
+    {
+        if (bad[t]) Fail(file_path, "bad token in edge list");
+        first[t + 1] = first[t] + (long long) tokens[t].size();
+    }
+    if (first[threads] != 2LL * line)
+        Fail(file_path, "edge count does not match the header");
+    g->edge_item.resize(line);
+    g->edge_element.resize(line);
+    Run_Parallel(threads, [&](int t)
+    {
+        long long k = first[t];
+        for (int v: tokens[t])
+        {
+            if (k & 1) g->edge_element[k >> 1] = v;
+            else g->edge_item[k >> 1] = v;
+            k++;
+        }
+        std::vector<int>().swap(tokens[t]);
+    });
+    Finalize(g, file_path, threads);
+    return g;
+}
+
+BMCP::Graph *BMCP::Input_From_File(const int input_type, const char *file_path)
+{
+    if (input_type == 1)
+        return Fast_Input_From_File1(file_path);
+    else if (input_type == 2)
+        return Fast_Input_From_File2(file_path);
+    else if (input_type == 3)
+        return Input_From_Binary(file_path);
+    return nullptr;
+}
+
+bool BMCP::Input_Solution(const Graph *g, const char *file_path, std::vector<int> &items)
+{
+    FILE *file = fopen(file_path, "r");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "fail to open this file %s\n", file_path);
+        return false;
+    }
+    int largest = 0;
+    for (int i = 1; i <= g->m; i++)
+        largest = std::max(largest, g->Item_Origin(i));
+    std::vector<int> item_of(largest + 1, 0);
+    for (int i = 1; i <= g->m; i++)
+        item_of[g->Item_Origin(i)] = i;
+    items.clear();
+    int origin;
+    long long skipped = 0;
+    while (fscanf(file, "%d", &origin) == 1)
+    {
+        if (origin >= 1 && origin <= largest && item_of[origin] != 0) items.push_back(item_of[origin]);
+        else skipped++;
+    }
+    bool ok = feof(file);
+    fclose(file);
+    if (!ok)
+    {
+        fprintf(stderr, "bad item id in %s\n", file_path);
+        return false;
+    }
+    if (skipped > 0)
+        fprintf(stderr, "%lld items of %s are not in the instance\n", skipped, file_path);
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+    return true;
+}
@@ -0,0 +1,29 @@
+#ifndef BANDBMCP_READER_HPP
+#define BANDBMCP_READER_HPP
+
+#include <Graph.hpp>
+#include <vector>
+
+namespace BMCP
+{
+    //input_type 1: dense relation matrix, one fscanf per cell
+    Graph *Input_From_File1(const char *);
+
+    //input_type 1: mapped file, relation matrix scanned with SIMD
+    Graph *Fast_Input_From_File1(const char *);
+
+    //input_type 2: edge list
+    Graph *Input_From_File2(const char *);
+
+    //input_type 2: mapped file, edge list tokenized by several threads (0: one per core)
+    Graph *Fast_Input_From_File2(const char *, int threads = 0);
+
+    //dispatch on input_type, nullptr if the type is unknown
+    Graph *Input_From_File(int, const char *);
+
+    //item ids as written by Output_Solution (numbered as in the input file), mapped to the ids of
+    //g; ids g no longer has, e.g. after a reduction, are skipped. False if the file cannot be read
+    bool Input_Solution(const Graph *, const char *, std::vector<int> &);
+}
+
+#endif //BANDBMCP_READER_HPP
@@ -0,0 +1,233 @@
+#include <Reduction.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct Reducer
+    {
+        const BMCP::Graph *g;
+        BMCP::ReductionReport &report;
+
+        std::vector<char> item_alive;
+        std::vector<char> element_alive;
+        //profit of an element after equivalent ones were folded into it
+        std::vector<long long> profit;
+        //alive degrees
+        std::vector<int> item_degree;
+        std::vector<int> element_degree;
+        std::vector<int> stamp;
+
+        //an item is compared element by element with at most this many candidates per round,
+        //and the rounds stop after max_rounds even if the last one still changed something
+        static constexpr int dominance_candidates = 32;
+        static constexpr int max_rounds = 16;
+
+        Reducer(const BMCP::Graph *g, BMCP::ReductionReport &report) :
+                g(g), report(report), item_alive(g->m + 1, 1), element_alive(g->n + 1, 1),
+                profit(g->n + 1), item_degree(g->m + 1, 0), element_degree(g->n + 1, 0),
+                stamp(std::max(g->m, g->n) + 1, 0)
+        {
+            for (int j = 1; j <= g->n; j++)
+                profit[j] = g->profit[j];
+        }
+
+        void Count_Degrees()
+        {
+            std::fill(item_degree.begin(), item_degree.end(), 0);
+            std::fill(element_degree.begin(), element_degree.end(), 0);
+            for (int i = 1; i <= g->m; i++)
+            {
+                if (!item_alive[i]) continue;
+                for (int elem: g->item_neighbor[i])
+                {
+                    if (!element_alive[elem]) continue;
+                    item_degree[i]++;
+                    element_degree[elem]++;
+                }
+            }
+        }
+
+        bool Drop_Infeasible_Items()
+        {
+            bool changed = false;
+            for (int i = 1; i <= g->m; i++)
+            {
+                if (!item_alive[i]) continue;
+                if (g->weight[i] <= g->C && item_degree[i] > 0) continue;
+                item_alive[i] = 0;
+                report.infeasible_items++;
+                changed = true;
+            }
+            return changed;
+        }
+
+        bool Drop_Uncovered_Elements()
+        {
+            bool changed = false;
+            for (int j = 1; j <= g->n; j++)
+            {
+                if (!element_alive[j] || element_degree[j] > 0) continue;
+                element_alive[j] = 0;
+                report.uncovered_elements++;
+                changed = true;
+            }
+            return changed;
+        }
+
+        //alive items of element j, sorted
+        void Item_Set(int j, std::vector<int> &items) const
+        {
+            items.clear();
+            for (int item: g->element_neighbor[j])
+                if (item_alive[item]) items.push_back(item);
+            std::sort(items.begin(), items.end());
+        }
+
+        bool Merge_Equivalent_Elements()
+        {
+            //bucket elements by a hash of their item set, compare exactly inside a bucket
+            std::unordered_map<unsigned long long, std::vector<int>> bucket;
+            std::vector<int> items;
+            for (int j = 1; j <= g->n; j++)
+            {
+                if (!element_alive[j]) continue;
+                Item_Set(j, items);
+                unsigned long long hash = items.size();
+                for (int item: items)
+                    hash = (hash ^ (unsigned long long) item) * 0x100000001b3ULL;
+                bucket[hash].push_back(j);
+            }
+            bool changed = false;
+            std::vector<int> other;
+            for (auto &entry: bucket)
+            {
+                std::vector<int> &list = entry.second;
+                for (size_t a = 0; a < list.size(); a++)
+                {
+                    int first = list[a];
+                    if (!element_alive[first]) continue;
+                    Item_Set(first, items);
+                    for (size_t b = a + 1; b < list.size(); b++)
+                    {
+                        int second = list[b];
+                        if (!element_alive[second]) continue;
+                        Item_Set(second, other);
+                        if (other != items) continue;
+                        //profits are stored as int: elements whose sum would not fit stay apart
+                        if (profit[first] + profit[second] > INT_MAX) continue;
+                        profit[first] += profit[second];
+                        element_alive[second] = 0;
+                        report.merged_elements++;
+                        changed = true;
+                    }
+                }
+            }
+            return changed;
+        }
+
+        bool Drop_Dominated_Items()
+        {
+            bool changed = false;
+            for (int i = 1; i <= g->m; i++)
+            {
+                if (!item_alive[i]) continue;
+                //a dominating item covers every element of i, in particular the rarest one
+                int rarest = -1;
+                for (int elem: g->item_neighbor[i])
+                {
+                    if (!element_alive[elem]) continue;
+                    stamp[elem] = i;
+                    if (rarest == -1 || element_degree[elem] < element_degree[rarest])
+                        rarest = elem;
+                }
+                if (rarest == -1) continue;
+                int compared = 0;
+                for (int other: g->element_neighbor[rarest])
+                {
+                    if (other == i || !item_alive[other]) continue;
+                    if (g->weight[other] > g->weight[i] || item_degree[other] < item_degree[i]) continue;
+                    //identical sets and weights: keep the lower id
+                    if (g->weight[other] == g->weight[i] && item_degree[other] == item_degree[i] && other > i)
+                        continue;
+                    if (compared++ == dominance_candidates) break;
+                    int covered = 0;
+                    for (int elem: g->item_neighbor[other])
+                        if (element_alive[elem] && stamp[elem] == i) covered++;
+                    if (covered != item_degree[i]) continue;
+                    item_alive[i] = 0;
+                    report.dominated_items++;
+                    changed = true;
+                    break;
+                }
+            }
+            return changed;
+        }
+
+        BMCP::Graph *Build()
+        {
+            std::vector<int> item_id(g->m + 1, 0), element_id(g->n + 1, 0);
+            int m = 0, n = 0;
+            for (int i = 1; i <= g->m; i++)
+                if (item_alive[i]) item_id[i] = ++m;
+            for (int j = 1; j <= g->n; j++)
+                if (element_alive[j]) element_id[j] = ++n;
+            auto *reduced = new BMCP::Graph(m, n, g->C);
+            reduced->item_origin = new int[m + 1];
+            reduced->item_origin[0] = 0;
+            for (int i = 1; i <= g->m; i++)
+            {
+                if (!item_alive[i]) continue;
+                reduced->weight[item_id[i]] = g->weight[i];
+                reduced->item_origin[item_id[i]] = g->Item_Origin(i);
+                for (int elem: g->item_neighbor[i])
+                    if (element_alive[elem]) reduced->Add_Edge(item_id[i], element_id[elem]);
+            }
+            for (int j = 1; j <= g->n; j++)
+                if (element_alive[j]) reduced->profit[element_id[j]] = (int) profit[j];
+            reduced->Finalize();
+            return reduced;
+        }
+    };
+}
+
+BMCP::Graph *BMCP::Reduce(const Graph *g, ReductionReport &report)
+{
+    report = ReductionReport{};
+    report.m_before = g->m;
+    report.n_before = g->n;
+    report.edges_before = g->item_neighbor.edges();
+
+    Reducer reducer(g, report);
+    //removing items can make elements uncovered or equivalent, and merging elements
+    //can expose new dominance, so repeat until nothing changes or max_rounds ran
+    bool changed = true;
+    for (int round = 0; changed && round < Reducer::max_rounds; round++)
+    {
+        reducer.Count_Degrees();
+        changed = reducer.Drop_Infeasible_Items();
+        reducer.Count_Degrees();
+        changed |= reducer.Drop_Uncovered_Elements();
+        changed |= reducer.Merge_Equivalent_Elements();
+        reducer.Count_Degrees();
+        changed |= reducer.Drop_Dominated_Items();
+    }
+
+    Graph *reduced = reducer.Build();
+    report.m_after = reduced->m;
+    report.n_after = reduced->n;
+    report.edges_after = reduced->item_neighbor.edges();
+    return reduced;
+}
+
+void BMCP::Print_Reduction_Report(const ReductionReport &report)
+{
+    fprintf(stderr, "reduction: items %d -> %d (%d infeasible, %d dominated), "
+                    "elements %d -> %d (%d uncovered, %d merged), edges %lld -> %lld\n",
+            report.m_before, report.m_after, report.infeasible_items, report.dominated_items,
+            report.n_before, report.n_after, report.uncovered_elements, report.merged_elements,
+            report.edges_before, report.edges_after);
+}
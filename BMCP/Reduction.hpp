@@ -0,0 +1,31 @@
+#ifndef BANDBMCP_REDUCTION_HPP
+#define BANDBMCP_REDUCTION_HPP
+
+#include <Graph.hpp>
+
+namespace BMCP
+{
+    struct ReductionReport
+    {
+        int m_before, m_after;
+        int n_before, n_after;
+        long long edges_before, edges_after;
+        //items heavier than C or covering nothing
+        int infeasible_items;
+        //items whose elements are all covered by a lighter (or equal, lower-id) item
+        int dominated_items;
+        //elements no remaining item covers
+        int uncovered_elements;
+        //elements folded into another one with the same item set, while the profit sum fits in an int
+        int merged_elements;
+    };
+
+    //build a smaller instance with the same optimum. Items keep their relative order,
+    //item_origin of the result maps back to the ids of g. The dominance test is bounded,
+    //so some dominated items may survive.
+    Graph *Reduce(const Graph *g, ReductionReport &report);
+
+    void Print_Reduction_Report(const ReductionReport &report);
+}
+
+#endif //BANDBMCP_REDUCTION_HPP
@@ -0,0 +1,89 @@
+#include <Reorder.hpp>
+#include <algorithm>
+#include <vector>
+
+BMCP::Graph *BMCP::Reorder(const Graph *g)
+{
+    //breadth-first over items and elements alternately, every component started from
+    //its lowest degree item and neighbors taken by increasing degree
+    std::vector<int> item_order, element_order;
+    item_order.reserve(g->m);
+    element_order.reserve(g->n);
+    std::vector<char> item_seen(g->m + 1, 0), element_seen(g->n + 1, 0);
+    std::vector<int> start(g->m);
+    for (int i = 0; i < g->m; i++)
+        start[i] = i + 1;
+    std::stable_sort(start.begin(), start.end(), [g](int a, int b)
+    {
+        return g->item_neighbor[a].size() < g->item_neighbor[b].size();
+    });
+    std::vector<int> next;
+    for (int root: start)
+    {
+        if (item_seen[root]) continue;
+        item_seen[root] = 1;
+        size_t item_head = item_order.size();
+        size_t element_head = element_order.size();
+        item_order.push_back(root);
+        while (item_head < item_order.size())
+        {
+            int item = item_order[item_head++];
+            next.clear();
+            for (int elem: g->item_neighbor[item])
+            {
+                if (element_seen[elem]) continue;
+                element_seen[elem] = 1;
+                next.push_back(elem);
+            }
+            std::stable_sort(next.begin(), next.end(), [g](int a, int b)
+            {
+                return g->element_neighbor[a].size() < g->element_neighbor[b].size();
+            });
+            element_order.insert(element_order.end(), next.begin(), next.end());
+            while (element_head < element_order.size())
+            {
+                int elem = element_order[element_head++];
+                next.clear();
+                for (int item_nei: g->element_neighbor[elem])
+                {
+                    if (item_seen[item_nei]) continue;
+                    item_seen[item_nei] = 1;
+                    next.push_back(item_nei);
+                }
+                std::stable_sort(next.begin(), next.end(), [g](int a, int b)
+                {
+                    return g->item_neighbor[a].size() < g->item_neighbor[b].size();
+                });
+                item_order.insert(item_order.end(), next.begin(), next.end());
+            }
+        }
+    }
+    for (int j = 1; j <= g->n; j++)
+        if (!element_seen[j]) element_order.push_back(j);
+    std::reverse(item_order.begin(), item_order.end());
+    std::reverse(element_order.begin(), element_order.end());
+
+    std::vector<int> element_id(g->n + 1);
+    for (int k = 0; k < g->n; k++)
+        element_id[element_order[k]] = k + 1;
+    auto *reordered = new Graph(g->m, g->n, g->C);
+    reordered->item_origin = new int[g->m + 1];
+    reordered->item_origin[0] = 0;
+    std::vector<int> elements;
+    for (int k = 0; k < g->m; k++)
+    {
+        int item = item_order[k];
+        reordered->weight[k + 1] = g->weight[item];
+        reordered->item_origin[k + 1] = g->Item_Origin(item);
+        elements.clear();
+        for (int elem: g->item_neighbor[item])
+            elements.push_back(element_id[elem]);
+        std::sort(elements.begin(), elements.end());
+        for (int elem: elements)
+            reordered->Add_Edge(k + 1, elem);
+    }
+    for (int j = 1; j <= g->n; j++)
+        reordered->profit[element_id[j]] = g->profit[j];
+    reordered->Finalize();
+    return reordered;
+}
@@ -0,0 +1,14 @@
+#ifndef BANDBMCP_REORDER_HPP
+#define BANDBMCP_REORDER_HPP
+
+#include <Graph.hpp>
+
+namespace BMCP
+{
+    //renumber items and elements in reverse Cuthill-McKee order of the bipartite graph,
+    //so items sharing elements get nearby ids and the elements of an item are close in
+    //memory. item_origin of the result maps back to the ids of the input file.
+    Graph *Reorder(const Graph *g);
+}
+
+#endif //BANDBMCP_REORDER_HPP
@@ -0,0 +1,91 @@
+#ifndef BANDBMCP_STATS_HPP
+#define BANDBMCP_STATS_HPP
+
+#include <chrono>
+
+//per-phase solver counters, collected only when built with BANDBMCP_STATS (cmake
+//-DBANDBMCP_STATS=ON); otherwise BMCP_STAT(...) expands to nothing and the solver carries
+//no counting code
+#ifdef BANDBMCP_STATS
+#define BMCP_STAT(...) __VA_ARGS__
+#else
+#define BMCP_STAT(...)
+#endif
+
+namespace BMCP
+{
+    //phase_solve is the Solve loop around the other phases; phase_snapshot the copies and
+    //roll backs between solution and best_solution, wherever they happen
+    enum Phase
+    {
+        phase_solve, phase_greedy, phase_cc_search, phase_deep_optimize, phase_restart, phase_snapshot, phase_count
+    };
+
+    inline const char *Phase_Name(const Phase phase)
+    {
+        static const char *const names[phase_count] = {"solve", "greedy_initialization", "cc_search",
+                                                       "deep_optimize", "restart", "snapshot"};
+        return names[phase];
+    }
+
+    struct PhaseStats
+    {
+        //exclusive: time in a nested phase is only counted there
+        double seconds = 0;
+        long long calls = 0;
+        //Add_Item / Remove_Item calls and the elements of the moved items
+        long long moves = 0;
+        long long elements = 0;
+        //passes over all items
+        long long scans = 0;
+        //new best solutions
+        long long improvements = 0;
+    };
+
+    struct SolverStats
+    {
+        PhaseStats phases[phase_count];
+        Phase phase = phase_solve;
+        std::chrono::steady_clock::time_point mark = std::chrono::steady_clock::now();
+
+        PhaseStats &current()
+        {
+            return phases[phase];
+        }
+
+        //charge the time since the last switch to the running phase and enter next
+        void enter(const Phase next)
+        {
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            phases[phase].seconds += std::chrono::duration<double>(now - mark).count();
+            mark = now;
+            phase = next;
+        }
+    };
+
+    //the enclosing scope runs as phase, the phase before is resumed on exit
+    class PhaseScope
+    {
+    private:
+        SolverStats &_stats;
+        Phase _outer;
+
+    public:
+        PhaseScope(SolverStats &stats, const Phase phase) : _stats(stats), _outer(stats.phase)
+        {
+            _stats.enter(phase);
+            _stats.current().calls++;
+        }
+
+        PhaseScope(const PhaseScope &) = delete;
+
+        PhaseScope &operator=(const PhaseScope &) = delete;
+
+        ~PhaseScope()
+        {
+            _stats.enter(_outer);
+        }
+    };
+}
+
+#endif //BANDBMCP_STATS_HPP
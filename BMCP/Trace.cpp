@@ -0,0 +1,63 @@
+#include <Trace.hpp>
+#include <algorithm>
+#include <cstring>
+
+BMCP::ImprovementTrace::ImprovementTrace(const int capacity) : _events(capacity), _total(0) {}
+
+void BMCP::ImprovementTrace::record(const Improvement &event)
+{
+    _events[_total % (long long) _events.size()] = event;
+    _total++;
+}
+
+long long BMCP::ImprovementTrace::total() const
+{
+    return _total;
+}
+
+std::vector<BMCP::Improvement> BMCP::ImprovementTrace::events() const
+{
+    long long size = (long long) _events.size();
+    std::vector<Improvement> result;
+    for (long long k = std::max(0LL, _total - size); k < _total; k++)
+        result.push_back(_events[k % size]);
+    return result;
+}
+
+void BMCP::ImprovementTrace::clear()
+{
+    _total = 0;
+}
+
+bool BMCP::Parse_Trace_Format(const char *name, TraceFormat &format)
+{
+    if (strcmp(name, "text") == 0) format = trace_text;
+    else if (strcmp(name, "csv") == 0) format = trace_csv;
+    else if (strcmp(name, "json") == 0) format = trace_json;
+    else return false;
+    return true;
+}
+
+bool BMCP::Write_Trace(const std::vector<Improvement> &events, FILE *file, const TraceFormat format)
+{
+    if (format == trace_csv)
+        fputs("time,iteration,profit,weight,phase\n", file);
+    else if (format == trace_json)
+        fputs("[\n", file);
+    for (size_t k = 0; k < events.size(); k++)
+    {
+        const Improvement &event = events[k];
+        if (format == trace_text)
+            fprintf(file, "%lf %d %lld\n", event.time, event.iteration, event.profit);
+        else if (format == trace_csv)
+            fprintf(file, "%.6f,%d,%lld,%lld,%s\n", event.time, event.iteration, event.profit, event.weight,
+                    Phase_Name(event.phase));
+        else
+            fprintf(file, "  {\"time\": %.6f, \"iteration\": %d, \"profit\": %lld, \"weight\": %lld, \"phase\": \"%s\"}%s\n",
+                    event.time, event.iteration, event.profit, event.weight, Phase_Name(event.phase),
+                    k + 1 < events.size() ? "," : "");
+    }
+    if (format == trace_json)
+        fputs("]\n", file);
+    return fflush(file) == 0;
+}
@@ -0,0 +1,61 @@
+#ifndef BANDBMCP_TRACE_HPP
+#define BANDBMCP_TRACE_HPP
+
+#include <Stats.hpp>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace BMCP
+{
+    //a new star solution
+    struct Improvement
+    {
+        //seconds since the solver started
+        double time;
+        int iteration;
+        long long profit;
+        long long weight;
+        //the phase that found it
+        Phase phase;
+    };
+
+    //called by the solving thread on every improvement
+    using ImprovementCallback = std::function<void(const Improvement &)>;
+
+    //the last capacity improvements in memory; older ones are overwritten and only counted, so
+    //a run with more than 4096 improvements by default loses the start of its trace. Nothing is
+    //written while the search runs, Write_Trace is called once it ended
+    class ImprovementTrace
+    {
+    private:
+        std::vector<Improvement> _events;
+        long long _total;
+
+    public:
+        explicit ImprovementTrace(int capacity = 1 << 12);
+
+        void record(const Improvement &);
+
+        //improvements recorded, including overwritten ones
+        long long total() const;
+
+        //the kept improvements, oldest first
+        std::vector<Improvement> events() const;
+
+        void clear();
+    };
+
+    enum TraceFormat
+    {
+        //"time iteration profit" lines, the historical stdout format
+        trace_text, trace_csv, trace_json
+    };
+
+    //false if the name is none of text, csv and json
+    bool Parse_Trace_Format(const char *, TraceFormat &);
+
+    bool Write_Trace(const std::vector<Improvement> &, FILE *, TraceFormat);
+}
+
+#endif //BANDBMCP_TRACE_HPP
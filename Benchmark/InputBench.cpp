@@ -0,0 +1,80 @@
+#include <Reader.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+//load time of the text readers: InputBench <input_type> <data_file> [repeat] [threads]
+
+static bool Same_Graph(BMCP::Graph *a, BMCP::Graph *b)
+{
+    if (a->m != b->m || a->n != b->n || a->C != b->C) return false;
+    for (int i = 1; i <= a->m; i++)
+    {
+        if (a->weight[i] != b->weight[i]) return false;
+        if (a->item_neighbor[i].size() != b->item_neighbor[i].size()) return false;
+        for (int k = 0; k < a->item_neighbor[i].size(); k++)
+            if (a->item_neighbor[i][k] != b->item_neighbor[i][k]) return false;
+    }
+    for (int j = 1; j <= a->n; j++)
+    {
+        if (a->profit[j] != b->profit[j]) return false;
+        if (a->element_neighbor[j].size() != b->element_neighbor[j].size()) return false;
+        for (int k = 0; k < a->element_neighbor[j].size(); k++)
+            if (a->element_neighbor[j][k] != b->element_neighbor[j][k]) return false;
+    }
+    return true;
+}
+
+template<typename Reader>
+static double Time_Reader(Reader reader, const char *file_path, int repeat, BMCP::Graph *&result)
+{
+    double best = 1e100;
+    for (int r = 0; r < repeat; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        BMCP::Graph *g = reader(file_path);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best) best = elapsed.count();
+        delete result;
+        result = g;
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fputs("usage: InputBench <input_type> <data_file> [repeat] [threads]\n", stderr);
+        return 1;
+    }
+    int input_type = atoi(argv[1]);
+    int repeat = argc > 3 ? atoi(argv[3]) : 3;
+    int threads = argc > 4 ? atoi(argv[4]) : 0;
+    BMCP::Graph *legacy = nullptr, *fast = nullptr;
+    double legacy_ms, fast_ms;
+    if (input_type == 1)
+    {
+        legacy_ms = Time_Reader(BMCP::Input_From_File1, argv[2], repeat, legacy);
+        fast_ms = Time_Reader(BMCP::Fast_Input_From_File1, argv[2], repeat, fast);
+    }
+    else if (input_type == 2)
+    {
+        legacy_ms = Time_Reader(BMCP::Input_From_File2, argv[2], repeat, legacy);
+        fast_ms = Time_Reader([threads](const char *file_path)
+                              {
+                                  return BMCP::Fast_Input_From_File2(file_path, threads);
+                              }, argv[2], repeat, fast);
+    }
+    else
+    {
+        fputs("Unknown or invalid input_type!\n", stderr);
+        return 1;
+    }
+    printf("fscanf %.3f ms\nfast   %.3f ms\nspeedup %.2fx\n", legacy_ms, fast_ms, legacy_ms / fast_ms);
+    bool same = Same_Graph(legacy, fast);
+    printf("graphs %s\n", same ? "identical" : "DIFFER");
+    delete legacy;
+    delete fast;
+    return same ? 0 : 1;
+}
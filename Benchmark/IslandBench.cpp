@@ -0,0 +1,48 @@
+#include <BMCP.hpp>
+#include <Portfolio.hpp>
+#include <Reader.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//portfolio and island scaling: IslandBench <input_type> <data_file> [max_threads] [time_limit] [migration] [ring|random]
+//runs 1, 2, 4, ... max_threads solvers for time_limit wall-clock seconds each round, so with a
+//core per solver iterations/s shows the scaling
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fputs("usage: IslandBench <input_type> <data_file> [max_threads] [time_limit] [migration] [ring|random]\n",
+              stderr);
+        return 1;
+    }
+    BMCP::Graph *g = BMCP::Input_From_File(atoi(argv[1]), argv[2]);
+    if (g == nullptr)
+    {
+        fputs("Unknown or invalid input_type!\n", stderr);
+        return 1;
+    }
+    int max_threads = argc > 3 ? atoi(argv[3]) : 64;
+    int time_limit = argc > 4 ? atoi(argv[4]) : 10;
+    int migration = argc > 5 ? atoi(argv[5]) : 5;
+    bool random_topology = argc > 6 && strcmp(argv[6], "random") == 0;
+
+    //the progress lines of the solvers go to stdout, the table to stderr
+    fprintf(stderr, "threads  wall s  iterations  iterations/s  profit\n");
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        auto start = std::chrono::steady_clock::now();
+        BMCP::PortfolioResult result = BMCP::With_Numeric(g, [&](auto numeric)
+        {
+            return BMCP::Solve_Portfolio<decltype(numeric)>(g, threads, 1, time_limit, 1000, 1000, 0.8, migration,
+                                                            random_topology, nullptr);
+        });
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        fprintf(stderr, "%7d  %6.2f  %10lld  %12.1f  %lld\n", threads, elapsed.count(), result.iterations,
+                result.iterations / elapsed.count(), result.profit);
+    }
+    delete g;
+    return 0;
+}
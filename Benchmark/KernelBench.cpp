@@ -0,0 +1,288 @@
+#include <BMCP.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+//kernel microbenchmarks on synthetic graphs: KernelBench [items] [operations]
+//every line reports ns/op and the bytes one op reads or writes, estimated from the arrays the
+//kernel accesses; "-" where the kernel walks a node based structure
+
+namespace BMCP
+{
+    using Clock = std::chrono::steady_clock;
+
+    static void Report(const char *name, const double ns, const double bytes)
+    {
+        if (bytes < 0) printf("%-36s %12.1f ns/op %12s B/op\n", name, ns, "-");
+        else printf("%-36s %12.1f ns/op %12.0f B/op\n", name, ns, bytes);
+    }
+
+    static double Nanoseconds(const Clock::time_point start, const long long ops)
+    {
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        return elapsed.count() / std::max(1LL, ops);
+    }
+
+    //m items and as many elements, every item on degree distinct random elements, capacity a
+    //tenth of the total weight
+    static Graph *Synthetic_Graph(const int m, const int degree, const unsigned int seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_int_distribution<int> value(1, 100);
+        std::uniform_int_distribution<int> element(1, m);
+        long long total_weight = 0;
+        auto *g = new Graph(m, m, 0);
+        for (int i = 1; i <= m; i++)
+        {
+            g->weight[i] = value(engine);
+            total_weight += g->weight[i];
+        }
+        for (int j = 1; j <= m; j++)
+            g->profit[j] = value(engine);
+        g->C = (int) (total_weight / 10);
+        for (int i = 1; i <= m; i++)
+        {
+            for (int k = 0; k < degree; k++)
+                g->Add_Edge(i, element(engine));
+        }
+        g->Finalize();
+        return g;
+    }
+
+    static void Bench_Lists(const int ops)
+    {
+        IntList list;
+        std::vector<int> order(ops);
+        std::mt19937 engine(1);
+        for (int k = 0; k < ops; k++)
+            order[k] = (int) (engine() % (unsigned int) (ops - k));
+
+        Clock::time_point start = Clock::now();
+        for (int k = 0; k < ops; k++)
+            list.push_back(k);
+        Report("IntList push_back", Nanoseconds(start, ops), sizeof(int));
+
+        start = Clock::now();
+        long long sum = 0;
+        for (int round = 0; round < 8; round++)
+        {
+            for (int item: list)
+                sum += item;
+        }
+        Report("IntList iterate", Nanoseconds(start, 8LL * ops), sizeof(int));
+
+        SetList set;
+        start = Clock::now();
+        for (int k = 0; k < ops; k++)
+            set.insert(k);
+        Report("SetList insert", Nanoseconds(start, ops), sizeof(int));
+
+        //erase at random positions: read the last entry, write it over the erased one
+        start = Clock::now();
+        for (int k = 0; k < ops; k++)
+            set.erase(order[k]);
+        Report("SetList erase", Nanoseconds(start, ops), 2 * sizeof(int));
+        if (sum == 42) puts("");
+    }
+
+    class KernelBench
+    {
+    public:
+        //bytes Add_Item / Remove_Item of item reads or writes in the current state: per element
+        //the index, count and owner; an element whose coverage starts or ends also updates the
+        //contribution of all its items, a second or last cover that of one item
+        template<typename Numeric>
+        static long long Move_Bytes(BMCPSolver<Numeric> &solver, const int item, const bool conf_change)
+        {
+            using value = typename Numeric::value;
+            using count = typename Numeric::count;
+            Graph *g = solver.g;
+            bool adding = !solver.solution[item];
+            long long per_neighbour = sizeof(int) + sizeof(int) + sizeof(value) + (conf_change ? 2 * sizeof(value) : 0);
+            long long bytes = 0;
+            for (int elem_nei: g->item_neighbor[item])
+            {
+                bytes += sizeof(int) + sizeof(count) + sizeof(int);
+                int covers = solver.solution_elements[elem_nei];
+                if (adding ? covers == 0 : covers == 1)
+                    bytes += sizeof(int) + per_neighbour * g->element_neighbor[elem_nei].size();
+                else if (adding ? covers == 1 : covers == 2)
+                    bytes += sizeof(int) + sizeof(int) + sizeof(value);
+            }
+            return bytes;
+        }
+
+        //the MoveBench walk: add picks while the weight fits, otherwise drop the in_solution
+        //entry the pick points at; with count set only the bytes are summed, untimed
+        template<typename Numeric>
+        static double Walk(BMCPSolver<Numeric> &solver, const std::vector<int> &picks, const bool conf_change,
+                           const bool count, long long &bytes)
+        {
+            bytes = 0;
+            Clock::time_point start = Clock::now();
+            int iter = 0;
+            for (int pick: picks)
+            {
+                int item = pick;
+                if (solver.solution_weight_sum <= solver.g->C)
+                {
+                    if (!solver.solution[pick])
+                    {
+                        if (count) bytes += Move_Bytes(solver, item, conf_change);
+                        solver.in_solution.insert(pick);
+                        if (conf_change) solver.Add_Item_With_Conf_Change(pick, iter);
+                        else solver.Add_Item(pick);
+                    }
+                }
+                else
+                {
+                    int idx = pick % solver.in_solution.size();
+                    item = solver.in_solution[idx];
+                    if (count) bytes += Move_Bytes(solver, item, conf_change);
+                    solver.in_solution.erase(idx);
+                    if (conf_change) solver.Remove_Item_With_Conf_Change(item, iter);
+                    else solver.Remove_Item(item);
+                }
+                iter++;
+            }
+            return Nanoseconds(start, (long long) picks.size());
+        }
+
+        template<typename Numeric>
+        static void Bench_Moves(Graph *g, const int ops, const int degree)
+        {
+            std::mt19937 engine(1);
+            std::uniform_int_distribution<int> pick(1, g->m);
+            std::vector<int> picks(ops);
+            for (int &item: picks)
+                item = pick(engine);
+            char name[64];
+            for (const bool conf_change: {false, true})
+            {
+                //the same walk twice from the greedy-free empty solution: timed, then counted
+                long long bytes;
+                BMCPSolver<Numeric> timed(g, 1, 0, 0, 0, 0.5);
+                double ns = Walk(timed, picks, conf_change, false, bytes);
+                BMCPSolver<Numeric> counted(g, 1, 0, 0, 0, 0.5);
+                Walk(counted, picks, conf_change, true, bytes);
+                snprintf(name, sizeof(name), "Add/Remove%s degree %d", conf_change ? " ConfChange" : "", degree);
+                Report(name, ns, 1.0 * bytes / ops);
+            }
+        }
+
+        template<typename Numeric>
+        static void Bench_Scans(Graph *g, const int ops)
+        {
+            using value = typename Numeric::value;
+            BMCPSolver<Numeric> solver(g, 1, 0, 0, 0, 0.5);
+            solver.Greedy_Initialization();
+            solver.Solution_To_Best_Solution();
+            int rounds = std::max(1, ops / g->m);
+
+            Clock::time_point start = Clock::now();
+            long long sum = 0;
+            for (int round = 0; round < rounds; round++)
+                sum += solver.Scan_Addable(round);
+            Report("Scan_Addable", Nanoseconds(start, rounds),
+                   (double) g->m * (sizeof(int) + sizeof(value) + sizeof(int)));
+
+            solver.Build_Candidates();
+            for (int i = 1; i <= g->m; i++)
+            {
+                solver.r_sum[i] = solver.r(i);
+                solver.select_times[i] = solver.solution[i];
+            }
+            solver.bandit_count = 0;
+            solver.Build_Arms();
+            start = Clock::now();
+            for (int round = 0; round < rounds; round++)
+                sum += solver.Select_Arm();
+            Report("Select_Arm", Nanoseconds(start, rounds), -1);
+            if (sum == 42) puts("");
+        }
+
+        template<typename Numeric>
+        static void Bench_Snapshots(Graph *g, const int ops)
+        {
+            using value = typename Numeric::value;
+            using count = typename Numeric::count;
+            BMCPSolver<Numeric> solver(g, 1, 0, 0, 0, 0.5);
+            solver.Greedy_Initialization();
+            int rounds = std::max(1, ops / g->m);
+            //one copy reads and writes the item arrays, the element arrays and in_solution
+            double bytes = 2.0 * ((double) g->m * (sizeof(int) + sizeof(value)) +
+                                  (double) g->n * (sizeof(count) + sizeof(int)) +
+                                  (double) solver.in_solution.size() * sizeof(int));
+
+            solver.journal_snapshots = false;
+            Clock::time_point start = Clock::now();
+            for (int round = 0; round < rounds; round++)
+                solver.Solution_To_Best_Solution();
+            Report("Solution_To_Best_Solution", Nanoseconds(start, rounds), bytes);
+
+            //includes rebuilding the candidate pool from the restored arrays
+            start = Clock::now();
+            for (int round = 0; round < rounds; round++)
+                solver.Best_Solution_To_Solution();
+            Report("Best_Solution_To_Solution", Nanoseconds(start, rounds),
+                   bytes + (double) g->m * (sizeof(int) + sizeof(value)));
+
+            //the copy plus undoing a short journal on it
+            solver.journal_snapshots = true;
+            std::vector<int> out;
+            for (int i = 1; i <= g->m && (int) out.size() < 8; i++)
+            {
+                if (!solver.solution[i]) out.push_back(i);
+            }
+            double total = 0;
+            for (int round = 0; round < rounds; round++)
+            {
+                solver.Solution_To_Best_Solution();
+                for (int item: out)
+                {
+                    solver.Add_Item(item);
+                    solver.Insert_In_Solution(item);
+                }
+                start = Clock::now();
+                solver.Checkpoint_Best();
+                total += Nanoseconds(start, 1);
+                for (int item: out)
+                {
+                    solver.Erase_In_Solution(solver.in_solution.size() - 1);
+                    solver.Remove_Item(item);
+                }
+            }
+            Report("Checkpoint_Best (8 journaled moves)", total / rounds, bytes);
+        }
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    int m = argc > 1 ? atoi(argv[1]) : 20000;
+    int ops = argc > 2 ? atoi(argv[2]) : 1000000;
+    if (m < 1 || ops < 1)
+    {
+        fputs("usage: KernelBench [items] [operations]\n", stderr);
+        return 1;
+    }
+    BMCP::Bench_Lists(ops);
+    for (const int degree: {4, 16, 64})
+    {
+        BMCP::Graph *g = BMCP::Synthetic_Graph(m, degree, 1);
+        BMCP::With_Numeric(g, [&](auto numeric)
+        {
+            using Numeric = decltype(numeric);
+            BMCP::KernelBench::Bench_Moves<Numeric>(g, ops, degree);
+            if (degree == 16)
+            {
+                BMCP::KernelBench::Bench_Scans<Numeric>(g, ops);
+                BMCP::KernelBench::Bench_Snapshots<Numeric>(g, ops);
+            }
+        });
+        delete g;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <BMCP.hpp>
+#include <Reader.hpp>
+#include <Reorder.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+//Add/Remove throughput: MoveBench <input_type> <data_file> [moves] [reorder]
+
+namespace BMCP
+{
+    class MoveBench
+    {
+    public:
+        //keep the solution around the knapsack size like the search does: add items[k] while
+        //the weight fits, otherwise drop the in_solution entry items[k] points at
+        template<typename Numeric>
+        static double Walk(BMCPSolver<Numeric> &solver, const std::vector<int> &items, bool conf_change)
+        {
+            auto start = std::chrono::steady_clock::now();
+            int iter = 0;
+            for (int pick: items)
+            {
+                if (solver.solution_weight_sum <= solver.g->C)
+                {
+                    if (!solver.solution[pick])
+                    {
+                        solver.in_solution.insert(pick);
+                        if (conf_change) solver.Add_Item_With_Conf_Change(pick, iter);
+                        else solver.Add_Item(pick);
+                    }
+                }
+                else
+                {
+                    int idx = pick % solver.in_solution.size();
+                    int item = solver.in_solution[idx];
+                    solver.in_solution.erase(idx);
+                    if (conf_change) solver.Remove_Item_With_Conf_Change(item, iter);
+                    else solver.Remove_Item(item);
+                }
+                iter++;
+            }
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            return elapsed.count() / std::max<size_t>(1, items.size());
+        }
+
+        template<typename Numeric>
+        static long long Profit(const BMCPSolver<Numeric> &solver)
+        {
+            return solver.solution_profit_sum;
+        }
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fputs("usage: MoveBench <input_type> <data_file> [moves] [reorder]\n", stderr);
+        return 1;
+    }
+    BMCP::Graph *g = BMCP::Input_From_File(atoi(argv[1]), argv[2]);
+    if (g == nullptr)
+    {
+        fputs("Unknown or invalid input_type!\n", stderr);
+        return 1;
+    }
+    int moves = argc > 3 ? atoi(argv[3]) : 1000000;
+    if (argc > 4 && atoi(argv[4]))
+    {
+        BMCP::Graph *reordered = BMCP::Reorder(g);
+        delete g;
+        g = reordered;
+    }
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<int> pick(1, g->m);
+    std::vector<int> items(moves);
+    for (int &item: items)
+        item = pick(engine);
+
+    BMCP::With_Numeric(g, [&](auto numeric)
+    {
+        BMCP::BMCPSolver<decltype(numeric)> solver(g, 1, 0, 0, 0, 0.5);
+        double plain = BMCP::MoveBench::Walk(solver, items, false);
+        long long profit = BMCP::MoveBench::Profit(solver);
+        double conf_change = BMCP::MoveBench::Walk(solver, items, true);
+        printf("Add/Remove                 %.1f ns/move\n", plain);
+        printf("Add/Remove with ConfChange %.1f ns/move\n", conf_change);
+        printf("checksum %lld %lld\n", profit, BMCP::MoveBench::Profit(solver));
+    });
+    delete g;
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <BMCP.hpp>
+#include <Reader.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+//best_solution snapshots, full copies against the undo log: SnapshotBench <input_type> <data_file> [rounds]
+
+namespace BMCP
+{
+    class SnapshotBench
+    {
+    public:
+        struct Result
+        {
+            double seconds;
+            ll copies;
+            ll rollbacks;
+            long long profit;
+        };
+
+        //the Solve loop without the clock and the star bookkeeping, so both modes do the same moves
+        template<typename Numeric>
+        static Result Run(Graph *g, int rounds, bool journal)
+        {
+            BMCPSolver<Numeric> solver(g, 1, 0, 1000, 1000, 0.8);
+            solver.journal_snapshots = journal;
+            long long profit = 0;
+            auto start = std::chrono::steady_clock::now();
+            solver.Greedy_Initialization();
+            for (int round = 0; round < rounds; round++)
+            {
+                solver.total_iterations++;
+                solver.CC_Search();
+                solver.Best_Solution_To_Solution();
+                solver.Deep_Optimize();
+                solver.Best_Solution_To_Solution();
+                profit = std::max<long long>(profit, solver.solution_profit_sum);
+                solver.Restart();
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            return {elapsed.count(), solver.snapshot_copies, solver.snapshot_rollbacks, profit};
+        }
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fputs("usage: SnapshotBench <input_type> <data_file> [rounds]\n", stderr);
+        return 1;
+    }
+    BMCP::Graph *g = BMCP::Input_From_File(atoi(argv[1]), argv[2]);
+    if (g == nullptr)
+    {
+        fputs("Unknown or invalid input_type!\n", stderr);
+        return 1;
+    }
+    int rounds = argc > 3 ? atoi(argv[3]) : 100;
+
+    bool same = BMCP::With_Numeric(g, [&](auto numeric)
+    {
+        using Numeric = decltype(numeric);
+        BMCP::SnapshotBench::Result copy = BMCP::SnapshotBench::Run<Numeric>(g, rounds, false);
+        BMCP::SnapshotBench::Result journal = BMCP::SnapshotBench::Run<Numeric>(g, rounds, true);
+        printf("copy     %.3f s  %lld copies\n", copy.seconds, copy.copies);
+        printf("journal  %.3f s  %lld copies  %lld moves rolled back\n", journal.seconds, journal.copies,
+               journal.rollbacks);
+        printf("checksum %lld %lld\n", copy.profit, journal.profit);
+        return copy.profit == journal.profit;
+    });
+    delete g;
+    return same ? 0 : 2;
+}
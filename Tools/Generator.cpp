@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//synthetic instances in the input_type 1 and 2 formats, see usage below. Everything is streamed
+//item by item, so only O(m + n) memory is held; the elements of item i come from a generator
+//seeded with (seed, i), so both formats and both passes over the items see the same graph
+
+namespace
+{
+    //splitmix64, cheap to seed once per item
+    class SplitMix
+    {
+    private:
+        uint64_t state;
+
+    public:
+        explicit SplitMix(const uint64_t seed) : state(seed) {}
+
+        uint64_t next()
+        {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        //uniform in [0, 1)
+        double uniform()
+        {
+            return (double) (next() >> 11) * 0x1.0p-53;
+        }
+
+        //uniform in [lo, hi]
+        int range(const int lo, const int hi)
+        {
+            return lo + (int) (next() % (uint64_t) (hi - lo + 1));
+        }
+    };
+
+    enum Distribution
+    {
+        uniform_distribution, normal_distribution, power_distribution, degree_distribution
+    };
+
+    struct Options
+    {
+        int m = 1000;
+        int n = 1000;
+        //mean number of elements per item; from density * n if not given
+        double degree = -1;
+        double density = 0.02;
+        //power-law exponent of the item degrees and of the element popularity, 0 for none
+        double skew = 0;
+        Distribution weight_distribution = uniform_distribution;
+        int weight_lo = 1, weight_hi = 100;
+        Distribution profit_distribution = uniform_distribution;
+        int profit_lo = 1, profit_hi = 100;
+        //knapsack size as a fraction of the total weight
+        double capacity = 0.05;
+        unsigned long long seed = 1;
+        int type = 2;
+        const char *output = nullptr;
+    };
+
+    bool Parse_Distribution(const char *arg, Distribution &distribution, const bool weight)
+    {
+        if (strcmp(arg, "uniform") == 0) distribution = uniform_distribution;
+        else if (strcmp(arg, "normal") == 0) distribution = normal_distribution;
+        else if (strcmp(arg, "power") == 0) distribution = power_distribution;
+        else if (weight && strcmp(arg, "degree") == 0) distribution = degree_distribution;
+        else return false;
+        return true;
+    }
+
+    bool Parse_Range(const char *arg, int &lo, int &hi)
+    {
+        return sscanf(arg, "%d:%d", &lo, &hi) == 2 && 0 <= lo && lo <= hi;
+    }
+
+    //a value in [lo, hi]: uniform; normal around the middle with sigma a sixth of the range;
+    //power: lo most of the time, with a heavy tail towards hi; degree: by the item degree
+    //relative to the largest one
+    int Draw(SplitMix &random, const Distribution distribution, const int lo, const int hi, const double degree_share)
+    {
+        double x;
+        switch (distribution)
+        {
+            case normal_distribution:
+            {
+                double u1 = std::max(random.uniform(), 1e-300);
+                double u2 = random.uniform();
+                double z = std::sqrt(-2 * std::log(u1)) * std::cos(2 * M_PI * u2);
+                x = std::clamp(0.5 + z / 6, 0.0, 1.0);
+                break;
+            }
+            case power_distribution:
+                x = std::pow(random.uniform(), 4.0);
+                break;
+            case degree_distribution:
+                x = std::clamp(degree_share + (random.uniform() - 0.5) * 0.1, 0.0, 1.0);
+                break;
+            default:
+                return random.range(lo, hi);
+        }
+        return lo + (int) std::lround(x * (hi - lo));
+    }
+
+    class Generator
+    {
+    private:
+        const Options &options;
+        std::vector<int> degree;
+        int max_degree = 1;
+        //element popularity: cumulative weights by rank, rank r is element rank_element[r]
+        std::vector<double> cumulative;
+        std::vector<int> rank_element;
+        std::vector<int> elements;
+
+        uint64_t Stream_Seed(const uint64_t stream, const uint64_t index) const
+        {
+            SplitMix mix(options.seed * 0x100000001b3ULL + stream);
+            return mix.next() ^ (index * 0x9e3779b97f4a7c15ULL);
+        }
+
+    public:
+        explicit Generator(const Options &options) : options(options) {}
+
+        void Build_Degrees()
+        {
+            double mean = options.degree >= 0 ? options.degree : options.density * options.n;
+            mean = std::clamp(mean, 1.0, (double) options.n);
+            SplitMix random(Stream_Seed(1, 0));
+            //item ranks are a random permutation, the item of rank r gets weight (r + 1)^-skew
+            std::vector<int> rank(options.m);
+            for (int i = 0; i < options.m; i++)
+                rank[i] = i;
+            for (int i = options.m - 1; i > 0; i--)
+                std::swap(rank[i], rank[random.next() % (uint64_t) (i + 1)]);
+            double total = 0;
+            for (int i = 0; i < options.m; i++)
+                total += std::pow(rank[i] + 1.0, -options.skew);
+            degree.assign(options.m + 1, 0);
+            for (int i = 1; i <= options.m; i++)
+            {
+                double share = std::pow(rank[i - 1] + 1.0, -options.skew) * options.m / total;
+                //random rounding keeps the mean
+                double target = mean * share;
+                int d = (int) target + (random.uniform() < target - (int) target ? 1 : 0);
+                degree[i] = std::clamp(d, 1, options.n);
+                max_degree = std::max(max_degree, degree[i]);
+            }
+
+            rank_element.resize(options.n);
+            for (int j = 0; j < options.n; j++)
+                rank_element[j] = j + 1;
+            for (int j = options.n - 1; j > 0; j--)
+                std::swap(rank_element[j], rank_element[random.next() % (uint64_t) (j + 1)]);
+            cumulative.resize(options.n);
+            double sum = 0;
+            for (int j = 0; j < options.n; j++)
+            {
+                sum += std::pow(j + 1.0, -options.skew);
+                cumulative[j] = sum;
+            }
+        }
+
+        //the distinct sorted elements of item; picks landing on an element twice are merged,
+        //so a hub-heavy item may end up slightly below its degree
+        const std::vector<int> &Item_Elements(const int item)
+        {
+            SplitMix random(Stream_Seed(2, item));
+            elements.clear();
+            int d = degree[item];
+            if (options.skew == 0 && d * 2 > options.n)
+            {
+                //dense row: keep every element with probability d / n
+                for (int j = 1; j <= options.n; j++)
+                {
+                    if (random.uniform() * options.n < d) elements.push_back(j);
+                }
+                if (elements.empty()) elements.push_back(random.range(1, options.n));
+                return elements;
+            }
+            for (int k = 0; k < d; k++)
+            {
+                if (options.skew == 0)
+                {
+                    elements.push_back(random.range(1, options.n));
+                    continue;
+                }
+                double x = random.uniform() * cumulative.back();
+                int r = (int) (std::upper_bound(cumulative.begin(), cumulative.end(), x) - cumulative.begin());
+                elements.push_back(rank_element[std::min(r, options.n - 1)]);
+            }
+            std::sort(elements.begin(), elements.end());
+            elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+            return elements;
+        }
+
+        void Draw_Values(std::vector<int> &weight, std::vector<int> &profit, long long &total_weight)
+        {
+            SplitMix random(Stream_Seed(3, 0));
+            weight.assign(options.m + 1, 0);
+            total_weight = 0;
+            for (int i = 1; i <= options.m; i++)
+            {
+                weight[i] = Draw(random, options.weight_distribution, options.weight_lo, options.weight_hi,
+                                 1.0 * degree[i] / max_degree);
+                total_weight += weight[i];
+            }
+            profit.assign(options.n + 1, 0);
+            for (int j = 1; j <= options.n; j++)
+                profit[j] = Draw(random, options.profit_distribution, options.profit_lo, options.profit_hi, 0);
+        }
+    };
+
+    void Write_Values(FILE *file, const std::vector<int> &values)
+    {
+        for (size_t k = 1; k < values.size(); k++)
+            fprintf(file, k + 1 < values.size() ? "%d " : "%d", values[k]);
+        fputc('\n', file);
+    }
+
+    bool Generate(const Options &options)
+    {
+        Generator generator(options);
+        generator.Build_Degrees();
+        std::vector<int> weight, profit;
+        long long total_weight;
+        generator.Draw_Values(weight, profit, total_weight);
+        int C = (int) std::min<long long>(INT_MAX, std::llround(options.capacity * total_weight));
+
+        FILE *file = fopen(options.output, "wb");
+        if (file == nullptr)
+        {
+            fprintf(stderr, "fail to open this file %s\n", options.output);
+            return false;
+        }
+        long long edges = 0;
+        if (options.type == 1)
+        {
+            fprintf(file, "\nm=%d n=%d knapsack size=%d\n\n", options.m, options.n, C);
+            fprintf(file, "The weight of %d items\n", options.m);
+            Write_Values(file, weight);
+            fprintf(file, "\nThe profit of %d elements\n", options.n);
+            Write_Values(file, profit);
+            fputs("\nRelation matix\n", file);
+            std::vector<char> row(2 * (size_t) options.n);
+            for (int i = 1; i <= options.m; i++)
+            {
+                for (int j = 0; j < options.n; j++)
+                {
+                    row[2 * j] = '0';
+                    row[2 * j + 1] = j + 1 < options.n ? ' ' : '\n';
+                }
+                const std::vector<int> &elems = generator.Item_Elements(i);
+                for (int j: elems)
+                    row[2 * (j - 1)] = '1';
+                edges += (long long) elems.size();
+                fwrite(row.data(), 1, row.size(), file);
+            }
+        }
+        else
+        {
+            //the edge count is only known at the end: leave a fixed-width field and fill it in
+            fprintf(file, "%d %d ", options.m, options.n);
+            long position = ftell(file);
+            fprintf(file, "%20lld %d\n", 0LL, C);
+            for (int i = 1; i <= options.m; i++)
+            {
+                for (int j: generator.Item_Elements(i))
+                {
+                    fprintf(file, "%d %d\n", i, j);
+                    edges++;
+                }
+            }
+            Write_Values(file, weight);
+            Write_Values(file, profit);
+            fseek(file, position, SEEK_SET);
+            fprintf(file, "%20lld", edges);
+        }
+        if (fclose(file) != 0)
+        {
+            fprintf(stderr, "fail to write this file %s\n", options.output);
+            return false;
+        }
+        fprintf(stderr, "m=%d n=%d edges=%lld C=%d total weight=%lld\n", options.m, options.n, edges, C,
+                total_weight);
+        return true;
+    }
+
+    void Usage()
+    {
+        fputs("usage: bmcp-gen --output <file> [--type 1|2] [--m items] [--n elements]\n"
+              "                [--degree mean | --density fraction] [--skew exponent]\n"
+              "                [--weight_dist uniform|normal|power|degree] [--weight_range lo:hi]\n"
+              "                [--profit_dist uniform|normal|power] [--profit_range lo:hi]\n"
+              "                [--capacity fraction] [--seed s]\n"
+              "type 1 writes the full m x n relation matrix, use type 2 for large instances\n", stderr);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    bool ok = argc % 2 == 1;
+    for (int i = 1; ok && i + 1 < argc; i += 2)
+    {
+        const char *arg = argv[i] + 2;
+        const char *value = argv[i + 1];
+        if (strncmp(argv[i], "--", 2) != 0) ok = false;
+        else if (strcmp(arg, "output") == 0) options.output = value;
+        else if (strcmp(arg, "type") == 0) ok = sscanf(value, "%d", &options.type) == 1;
+        else if (strcmp(arg, "m") == 0) ok = sscanf(value, "%d", &options.m) == 1;
+        else if (strcmp(arg, "n") == 0) ok = sscanf(value, "%d", &options.n) == 1;
+        else if (strcmp(arg, "degree") == 0) ok = sscanf(value, "%lf", &options.degree) == 1;
+        else if (strcmp(arg, "density") == 0) ok = sscanf(value, "%lf", &options.density) == 1;
+        else if (strcmp(arg, "skew") == 0) ok = sscanf(value, "%lf", &options.skew) == 1;
+        else if (strcmp(arg, "weight_dist") == 0) ok = Parse_Distribution(value, options.weight_distribution, true);
+        else if (strcmp(arg, "weight_range") == 0) ok = Parse_Range(value, options.weight_lo, options.weight_hi);
+        else if (strcmp(arg, "profit_dist") == 0) ok = Parse_Distribution(value, options.profit_distribution, false);
+        else if (strcmp(arg, "profit_range") == 0) ok = Parse_Range(value, options.profit_lo, options.profit_hi);
+        else if (strcmp(arg, "capacity") == 0) ok = sscanf(value, "%lf", &options.capacity) == 1;
+        else if (strcmp(arg, "seed") == 0) ok = sscanf(value, "%llu", &options.seed) == 1;
+        else ok = false;
+    }
+    ok = ok && options.output != nullptr && (options.type == 1 || options.type == 2) && options.m > 0 &&
+         options.n > 0 && options.skew >= 0 && options.capacity >= 0;
+    if (!ok)
+    {
+        Usage();
+        return 1;
+    }
+    return Generate(options) ? 0 : 1;
+}
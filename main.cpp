@@ -1,8 +1,14 @@
+#include <algorithm>
 #include <cstring>
 #include <BMCP.hpp>
+#include <Reader.hpp>
+#include <BinaryGraph.hpp>
+#include <Reduction.hpp>
+#include <Reorder.hpp>
+#include <Portfolio.hpp>
+#include <Control.hpp>
 
 BMCP::Graph *g;
-BMCP::BMCPSolver *solver;
 
 unsigned int seed;
 int time_limit;
@@ -10,7 +16,20 @@ int Imax1;
 int Imax2;
 int timestamp_gap;
 double lambda;
-int m, n, C;
+int reduce;
+int reorder;
+int threads = 1;
+int migration;
+int scan_threads = 1;
+int swap_samples;
+bool random_topology;
+BMCP::StopCriteria stop;
+char *solution_path;
+char *stats_path;
+char *trace_path;
+char *initial_path;
+std::vector<int> initial_solution;
+BMCP::TraceFormat trace_format = BMCP::trace_text;
 
 void Set_Time_Limit(char *ti_lim)
 {
@@ -37,78 +56,84 @@ void Set_Lambda(char *arg)
     sscanf(arg, "%lf", &lambda);
 }
 
-void Input_From_File1(char *file_path)
+void Set_Reduce(char *arg)
 {
-    FILE *file = fopen(file_path, "rb");
-    if (file == nullptr)
-    {
-        fprintf(stderr, "fail to open this file %s\n", file_path);
-        exit(1);
-    }
-    fscanf(file, "\n");
-    fscanf(file, "m=%d n=%d knapsack size=%d\n", &m, &n, &C);
-    g = new BMCP::Graph(m, n, C);
-    fscanf(file, "\n");
-    fscanf(file, "The weight of %*d items_next");
-    for (int i = 1; i <= g->m; i++)
-    {
-        fscanf(file, "%d", g->weight + i);
-    }
-    fscanf(file, "\n");
-    fscanf(file, "The profit of %*d elements_next");
-    for (int i = 1; i <= g->n; i++)
-    {
-        fscanf(file, "%d", g->profit + i);
-    }
-    fscanf(file, "\n");
-    fscanf(file, "Relation matix");
-    int relation;
-    for (int i = 1; i <= g->m; i++)
-    {
-        for (int j = 1; j <= g->n; j++)
-        {
-            fscanf(file, "%d", &relation);
-            if (relation)
-            {
-                g->item_neighbor[i].push_back(j);
-                g->element_neighbor[j].push_back(i);
-            }
-        }
-    }
+    sscanf(arg, "%d", &reduce);
+}
+
+void Set_Reorder(char *arg)
+{
+    sscanf(arg, "%d", &reorder);
+}
+
+void Set_Threads(char *arg)
+{
+    sscanf(arg, "%d", &threads);
+    threads = std::max(threads, 1);
+}
+
+void Set_Scan_Threads(char *arg)
+{
+    sscanf(arg, "%d", &scan_threads);
+    scan_threads = std::max(scan_threads, 1);
+}
+
+void Set_Swap(char *arg)
+{
+    sscanf(arg, "%d", &swap_samples);
+    swap_samples = std::max(swap_samples, 0);
+}
+
+void Set_Migration(char *arg)
+{
+    sscanf(arg, "%d", &migration);
+    migration = std::max(migration, 0);
+}
+
+void Set_Target(char *arg)
+{
+    sscanf(arg, "%lld", &stop.target);
 }
 
-void Input_From_File2(char *file_path)
+void Set_Stagnation(char *arg)
 {
-    FILE *file = fopen(file_path, "rb");
+    sscanf(arg, "%lf", &stop.stagnation);
+}
+
+void Set_Trace_Format(char *arg)
+{
+    if (!BMCP::Parse_Trace_Format(arg, trace_format))
+        fprintf(stderr, "unknown trace format %s, using text\n", arg);
+}
+
+//the improvements go to trace_path, or stdout, once the search ended; dropped counts the
+//earliest ones the ring buffer of a solver overwrote
+void Write_Trace(const std::vector<BMCP::Improvement> &events, const long long dropped)
+{
+    if (dropped > 0)
+        fprintf(stderr, "the trace misses %lld early improvements its buffer overwrote\n", dropped);
+    FILE *file = trace_path != nullptr ? fopen(trace_path, "w") : stdout;
     if (file == nullptr)
     {
-        fprintf(stderr, "fail to open this file %s\n", file_path);
-        exit(1);
-    }
-    int line;
-    fscanf(file, "%d %d %d %d", &m, &n, &line, &C);
-    g = new BMCP::Graph(m, n, C);
-    for (int i = 1; i <= line; i++)
-    {
-        int u, v;
-        fscanf(file, "%d %d", &u, &v);
-        g->item_neighbor[u].push_back(v);
-        g->element_neighbor[v].push_back(u);
-    }
-    for (int i = 1; i <= m; i++)
-    {
-        fscanf(file, "%d", g->weight + i);
-    }
-    for (int i = 1; i <= n; i++)
-    {
-        fscanf(file, "%d", g->profit + i);
+        fprintf(stderr, "fail to open this file %s\n", trace_path);
+        return;
     }
+    BMCP::Write_Trace(events, file, trace_format);
+    if (file != stdout) fclose(file);
+}
+
+void Set_Topology(char *arg)
+{
+    if (strcmp(arg, "random") == 0) random_topology = true;
+    else if (strcmp(arg, "ring") == 0) random_topology = false;
+    else fprintf(stderr, "unknown topology %s, using ring\n", arg);
 }
 
 int main(int argc, char *argv[])
 {
     char *arg;
     char *file_path = nullptr;
+    char *convert_path = nullptr;
     int input_type = -1;
     for (int i = 1; i < argc; i += 2)
     {
@@ -116,7 +141,7 @@ int main(int argc, char *argv[])
         if (strcmp(arg, "input_type") == 0)
             sscanf(argv[i + 1], "%d", &input_type);
     }
-    if (input_type != 1 && input_type != 2)
+    if (input_type != 1 && input_type != 2 && input_type != 3)
     {
         fputs("Unknown or invalid input_type!\n", stderr);
         return -1;
@@ -126,16 +151,22 @@ int main(int argc, char *argv[])
         arg = argv[i] + 2;
         if (strcmp(arg, "data_file") == 0)
             file_path = argv[i + 1];
+        else if (strcmp(arg, "convert_to") == 0)
+            convert_path = argv[i + 1];
     }
     if (file_path == nullptr)
     {
         fputs("Unknown or invalid file_path!\n", stderr);
         return 1;
     }
-    if (input_type == 1)
-        Input_From_File1(file_path);
-    else if (input_type == 2)
-        Input_From_File2(file_path);
+    g = BMCP::Input_From_File(input_type, file_path);
+    //converter mode: write the graph as input_type 3 and quit
+    if (convert_path != nullptr)
+    {
+        bool ok = BMCP::Output_To_Binary(g, convert_path);
+        delete g;
+        return ok ? 0 : 1;
+    }
     for (int i = 1; i < argc; i += 2)
     {
         arg = argv[i] + 2;
@@ -148,14 +179,71 @@ int main(int argc, char *argv[])
         //else if (strcmp(arg, "tabu_length1") == 0) Set_Timestamp_Gap(argv[i + 1]);
         else if (strcmp(arg, "lambda") == 0) Set_Lambda(argv[i + 1]);
         else if (strcmp(arg, "imax2") == 0) Set_Imax2(argv[i + 1]);
+        else if (strcmp(arg, "reduce") == 0) Set_Reduce(argv[i + 1]);
+        else if (strcmp(arg, "reorder") == 0) Set_Reorder(argv[i + 1]);
+        else if (strcmp(arg, "threads") == 0) Set_Threads(argv[i + 1]);
+        else if (strcmp(arg, "migration") == 0) Set_Migration(argv[i + 1]);
+        else if (strcmp(arg, "scan_threads") == 0) Set_Scan_Threads(argv[i + 1]);
+        else if (strcmp(arg, "swap") == 0) Set_Swap(argv[i + 1]);
+        else if (strcmp(arg, "topology") == 0) Set_Topology(argv[i + 1]);
+        else if (strcmp(arg, "target") == 0) Set_Target(argv[i + 1]);
+        else if (strcmp(arg, "stagnation") == 0) Set_Stagnation(argv[i + 1]);
+        else if (strcmp(arg, "solution_file") == 0) solution_path = argv[i + 1];
+        else if (strcmp(arg, "stats_file") == 0) stats_path = argv[i + 1];
+        else if (strcmp(arg, "initial_solution") == 0) initial_path = argv[i + 1];
+        else if (strcmp(arg, "trace_file") == 0) trace_path = argv[i + 1];
+        else if (strcmp(arg, "trace_format") == 0) Set_Trace_Format(argv[i + 1]);
     }
-    solver = new BMCP::BMCPSolver(g, seed, time_limit, Imax1, Imax2,
-                                  lambda);
-    solver->Solve();
-
-    solver->Output();
+    if (reduce)
+    {
+        BMCP::ReductionReport report;
+        BMCP::Graph *reduced = BMCP::Reduce(g, report);
+        BMCP::Print_Reduction_Report(report);
+        delete g;
+        g = reduced;
+    }
+    if (reorder)
+    {
+        BMCP::Graph *reordered = BMCP::Reorder(g);
+        delete g;
+        g = reordered;
+    }
+    //read after the reduction and renumbering, the ids are mapped through item_origin
+    if (initial_path != nullptr && !BMCP::Input_Solution(g, initial_path, initial_solution))
+    {
+        delete g;
+        return 1;
+    }
+    //the first SIGINT / SIGTERM ends the search, the best solution so far is still written
+    BMCP::Install_Stop_Handlers();
+    BMCP::With_Numeric(g, [](auto numeric)
+    {
+        if (threads > 1)
+        {
+            BMCP::PortfolioResult result = BMCP::Solve_Portfolio<decltype(numeric)>(
+                    g, threads, seed, time_limit, Imax1, Imax2, lambda, migration, random_topology, solution_path,
+                    stop, swap_samples, initial_solution);
+            Write_Trace(result.trace, result.trace_dropped);
+            return;
+        }
+        BMCP::BMCPSolver<decltype(numeric)> solver(g, seed, time_limit, Imax1, Imax2,
+                                                   lambda);
+        solver.Set_Stop_Criteria(stop);
+        solver.Use_Swaps(swap_samples);
+        solver.Set_Initial_Solution(initial_solution);
+        BMCP::WorkerPool pool(scan_threads);
+        if (scan_threads > 1)
+            solver.Use_Pool(&pool);
+        solver.Solve();
+        std::vector<BMCP::Improvement> events = solver.Trace().events();
+        Write_Trace(events, solver.Trace().total() - (long long) events.size());
 
-    delete solver;
+        solver.Output();
+        if (solution_path != nullptr)
+            solver.Output_Solution(solution_path);
+        if (stats_path != nullptr)
+            solver.Output_Stats(stats_path);
+    });
 
     delete g;
     return 0;